@@ -12,9 +12,12 @@
 #include "HalPolicy.hpp"
 
 #include "../ArmnnDriverImpl.hpp"
+#include "../RequestThread.hpp"
 
 #include <log/log.h>
 
+#include <memory>
+
 namespace armnn_driver
 {
 namespace hal_1_0
@@ -25,6 +28,10 @@ class ArmnnDriver : public ArmnnDevice, public V1_0::IDevice
 public:
     ArmnnDriver(DriverOptions options)
         : ArmnnDevice(std::move(options))
+        , m_RequestThread(std::make_shared<RequestThread<HalPolicy>>(
+              m_Options.GetNumberOfRequestThreads(),
+              m_Options.GetRequestThreadScheduling(),
+              std::make_shared<PendingRequestLimit>(m_Options.GetMaxPendingRequests())))
     {
         ALOGV("hal_1_0::ArmnnDriver::ArmnnDriver()");
     }
@@ -43,7 +50,11 @@ public:
     {
         ALOGV("hal_1_0::ArmnnDriver::getSupportedOperations()");
 
-        return armnn_driver::ArmnnDriverImpl<HalPolicy>::getSupportedOperations(m_Runtime, m_Options, model, cb);
+        return armnn_driver::ArmnnDriverImpl<HalPolicy>::getSupportedOperations(m_Runtime,
+                                                                                m_ConvertedNetworkCache,
+                                                                                m_Options,
+                                                                                model,
+                                                                                cb);
     }
 
     Return<ErrorStatus> prepareModel(const V1_0::Model& model,
@@ -53,6 +64,12 @@ public:
 
         return armnn_driver::ArmnnDriverImpl<HalPolicy>::prepareModel(m_Runtime,
                                                                       m_ClTunedParameters,
+                                                                      m_RequestThread,
+                                                                      m_NetworkCache,
+                                                                      m_ConvertedNetworkCache,
+                                                                      m_LoadedNetworkBudget,
+                                                                      m_ClProgramCache,
+                                                                      m_PreparationPool,
                                                                       m_Options,
                                                                       model,
                                                                       cb);
@@ -64,6 +81,9 @@ public:
 
         return armnn_driver::ArmnnDriverImpl<HalPolicy>::getStatus();
     }
+
+private:
+    std::shared_ptr<RequestThread<HalPolicy>> m_RequestThread;
 };
 
 } // namespace hal_1_0
@@ -432,7 +432,9 @@ bool HalPolicy::ConvertConv2d(const Operation& operation, const Model& model, Co
         return false;
     }
 
-    armnn::IConnectableLayer* startLayer = data.m_Network->AddConvolution2dLayer(desc, weights, bias);
+    armnn::IConnectableLayer* startLayer = data.m_Mode == ConversionMode::DryRun ?
+        AddDryRunPlaceholderLayer(data) :
+        data.m_Network->AddConvolution2dLayer(desc, weights, bias);
 
     if (!startLayer)
     {
@@ -558,7 +560,9 @@ bool HalPolicy::ConvertDepthwiseConv2d(const Operation& operation, const Model&
         return false;
     }
 
-    armnn::IConnectableLayer* startLayer = data.m_Network->AddDepthwiseConvolution2dLayer(desc, weights, bias);
+    armnn::IConnectableLayer* startLayer = data.m_Mode == ConversionMode::DryRun ?
+        AddDryRunPlaceholderLayer(data) :
+        data.m_Network->AddDepthwiseConvolution2dLayer(desc, weights, bias);
     if (!startLayer)
     {
         return Fail("%s: AddDepthwiseConvolution2dLayer failed", __func__);
@@ -679,7 +683,9 @@ bool HalPolicy::ConvertFullyConnected(const Operation& operation, const Model& m
         return false;
     }
 
-    armnn::IConnectableLayer* startLayer = data.m_Network->AddFullyConnectedLayer(desc, weights, bias);
+    armnn::IConnectableLayer* startLayer = data.m_Mode == ConversionMode::DryRun ?
+        AddDryRunPlaceholderLayer(data) :
+        data.m_Network->AddFullyConnectedLayer(desc, weights, bias);
     armnn::IConnectableLayer* endLayer = ProcessActivation(outputInfo, activationFunction, startLayer, data);
 
     if (endLayer != nullptr)
@@ -1061,6 +1067,13 @@ bool HalPolicy::ConvertLstm(const Operation& operation, const Model& model, Conv
         return false;
     }
 
+    // No layer has the inputs and outputs of an LSTM to stand in for it in a dry run, in which case the operations
+    // using its outputs are not connected to it
+    if (data.m_Mode == ConversionMode::DryRun)
+    {
+        return true;
+    }
+
     // Add the layer
     armnn::IConnectableLayer* layer = data.m_Network->AddLstmLayer(desc, params, "Lstm");
 
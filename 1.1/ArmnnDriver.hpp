@@ -15,8 +15,12 @@
 #include "../1.0/ArmnnDriverImpl.hpp"
 #include "../1.0/HalPolicy.hpp"
 
+#include "../RequestThread.hpp"
+
 #include <log/log.h>
 
+#include <memory>
+
 namespace armnn_driver
 {
 namespace hal_1_1
@@ -27,6 +31,15 @@ class ArmnnDriver : public ArmnnDevice, public V1_1::IDevice
 public:
     ArmnnDriver(DriverOptions options)
         : ArmnnDevice(std::move(options))
+        , m_PendingRequestLimit(std::make_shared<PendingRequestLimit>(m_Options.GetMaxPendingRequests()))
+        , m_RequestThread_1_0(
+              std::make_shared<RequestThread<hal_1_0::HalPolicy>>(m_Options.GetNumberOfRequestThreads(),
+                                                                  m_Options.GetRequestThreadScheduling(),
+                                                                  m_PendingRequestLimit))
+        , m_RequestThread_1_1(
+              std::make_shared<RequestThread<hal_1_1::HalPolicy>>(m_Options.GetNumberOfRequestThreads(),
+                                                                  m_Options.GetRequestThreadScheduling(),
+                                                                  m_PendingRequestLimit))
     {
         ALOGV("hal_1_1::ArmnnDriver::ArmnnDriver()");
     }
@@ -46,6 +59,7 @@ public:
         ALOGV("hal_1_1::ArmnnDriver::getSupportedOperations()");
 
         return armnn_driver::ArmnnDriverImpl<hal_1_0::HalPolicy>::getSupportedOperations(m_Runtime,
+                                                                                         m_ConvertedNetworkCache,
                                                                                          m_Options,
                                                                                          model,
                                                                                          cb);
@@ -58,6 +72,12 @@ public:
 
         return armnn_driver::ArmnnDriverImpl<hal_1_0::HalPolicy>::prepareModel(m_Runtime,
                                                                                m_ClTunedParameters,
+                                                                               m_RequestThread_1_0,
+                                                                               m_NetworkCache,
+                                                                               m_ConvertedNetworkCache,
+                                                                               m_LoadedNetworkBudget,
+                                                                               m_ClProgramCache,
+                                                                               m_PreparationPool,
                                                                                m_Options,
                                                                                model,
                                                                                cb);
@@ -76,6 +96,7 @@ public:
         ALOGV("hal_1_1::ArmnnDriver::getSupportedOperations_1_1()");
 
         return armnn_driver::ArmnnDriverImpl<hal_1_1::HalPolicy>::getSupportedOperations(m_Runtime,
+                                                                                         m_ConvertedNetworkCache,
                                                                                          m_Options,
                                                                                          model,
                                                                                          cb);
@@ -96,13 +117,23 @@ public:
             return ErrorStatus::INVALID_ARGUMENT;
         }
 
+        const PerformancePreference performancePreference =
+            hal_1_1::ArmnnDriverImpl::GetPerformancePreference(preference);
+
         return armnn_driver::ArmnnDriverImpl<hal_1_1::HalPolicy>::prepareModel(m_Runtime,
                                                                                m_ClTunedParameters,
+                                                                               m_RequestThread_1_1,
+                                                                               m_NetworkCache,
+                                                                               m_ConvertedNetworkCache,
+                                                                               m_LoadedNetworkBudget,
+                                                                               m_ClProgramCache,
+                                                                               m_PreparationPool,
                                                                                m_Options,
                                                                                model,
                                                                                cb,
                                                                                model.relaxComputationFloat32toFloat16
-                                                                               && m_Options.GetFp16Enabled());
+                                                                               && m_Options.GetFp16Enabled(),
+                                                                               performancePreference);
     }
 
     Return<DeviceStatus> getStatus() override
@@ -111,6 +142,12 @@ public:
 
         return armnn_driver::ArmnnDriverImpl<hal_1_1::HalPolicy>::getStatus();
     }
+
+private:
+    // The limit on the pending requests applies to the models of both HAL versions
+    std::shared_ptr<PendingRequestLimit>               m_PendingRequestLimit;
+    std::shared_ptr<RequestThread<hal_1_0::HalPolicy>> m_RequestThread_1_0;
+    std::shared_ptr<RequestThread<hal_1_1::HalPolicy>> m_RequestThread_1_1;
 };
 
 } // namespace hal_1_1
@@ -63,5 +63,19 @@ Return<void> ArmnnDriverImpl::getCapabilities_1_1(const armnn::IRuntimePtr& runt
     return Void();
 }
 
+PerformancePreference ArmnnDriverImpl::GetPerformancePreference(V1_1::ExecutionPreference preference)
+{
+    switch (preference)
+    {
+        case V1_1::ExecutionPreference::LOW_POWER:
+            return PerformancePreference::LowPower;
+        case V1_1::ExecutionPreference::SUSTAINED_SPEED:
+            return PerformancePreference::SustainedSpeed;
+        case V1_1::ExecutionPreference::FAST_SINGLE_ANSWER:
+        default:
+            return PerformancePreference::FastSingleAnswer;
+    }
+}
+
 } // namespace hal_1_1
 } // namespace armnn_driver
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include <HalInterfaces.h>
 
+#include "../ArmnnDriverImpl.hpp"
 #include "../DriverOptions.hpp"
 
 #include <armnn/ArmNN.hpp>
@@ -21,6 +22,9 @@ class ArmnnDriverImpl
 public:
     static Return<void> getCapabilities_1_1(const armnn::IRuntimePtr& runtime,
                                             V1_1::IDevice::getCapabilities_1_1_cb cb);
+
+    /// Converts a validated execution preference into the preference stored on the prepared model
+    static PerformancePreference GetPerformancePreference(V1_1::ExecutionPreference preference);
 };
 
 } // namespace hal_1_1
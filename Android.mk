@@ -53,8 +53,24 @@ LOCAL_SRC_FILES := \
         DriverOptions.cpp \
         ArmnnDevice.cpp \
         ArmnnPreparedModel.cpp \
+        CacheFile.cpp \
+        ClProgramCache.cpp \
+        ConstTensorStore.cpp \
+        ConvertedNetworkCache.cpp \
+        LoadedNetworkBudget.cpp \
+        MemoryPoolCache.cpp \
+        ModelHash.cpp \
+        OperationSupportCache.cpp \
+        PendingRequestLimit.cpp \
+        PreparationPool.cpp \
+        PrepareReport.cpp \
+        PreparedNetworkCache.cpp \
         ModelToINetworkConverter.cpp \
+        RequestBatching.cpp \
+        RequestSlotPool.cpp \
         RequestThread.cpp \
+        RequestTimings.cpp \
+        ThreadScheduling.cpp \
         Utils.cpp \
         ConversionUtils.cpp
 
@@ -70,6 +86,7 @@ LOCAL_WHOLE_STATIC_LIBRARIES := libarmnn
 
 LOCAL_SHARED_LIBRARIES := \
         libbase \
+        libcrypto \
         libhidlbase \
         libhidltransport \
         libhidlmemory \
@@ -130,8 +147,24 @@ LOCAL_SRC_FILES := \
         DriverOptions.cpp \
         ArmnnDevice.cpp \
         ArmnnPreparedModel.cpp \
+        CacheFile.cpp \
+        ClProgramCache.cpp \
+        ConstTensorStore.cpp \
+        ConvertedNetworkCache.cpp \
+        LoadedNetworkBudget.cpp \
+        MemoryPoolCache.cpp \
+        ModelHash.cpp \
+        OperationSupportCache.cpp \
+        PendingRequestLimit.cpp \
+        PreparationPool.cpp \
+        PrepareReport.cpp \
+        PreparedNetworkCache.cpp \
         ModelToINetworkConverter.cpp \
+        RequestBatching.cpp \
+        RequestSlotPool.cpp \
         RequestThread.cpp \
+        RequestTimings.cpp \
+        ThreadScheduling.cpp \
         Utils.cpp \
         ConversionUtils.cpp
 
@@ -147,6 +180,7 @@ LOCAL_WHOLE_STATIC_LIBRARIES := libarmnn
 
 LOCAL_SHARED_LIBRARIES := \
         libbase \
+        libcrypto \
         libhidlbase \
         libhidltransport \
         libhidlmemory \
@@ -204,6 +238,7 @@ LOCAL_WHOLE_STATIC_LIBRARIES := \
 
 LOCAL_SHARED_LIBRARIES := \
         libbase \
+        libcrypto \
         libhidlbase \
         libhidltransport \
         libhidlmemory \
@@ -271,6 +306,7 @@ LOCAL_WHOLE_STATIC_LIBRARIES := \
 
 LOCAL_SHARED_LIBRARIES := \
         libbase \
+        libcrypto \
         libhidlbase \
         libhidltransport \
         libhidlmemory \
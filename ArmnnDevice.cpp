@@ -11,10 +11,20 @@
 
 #include <log/log.h>
 
+#include <chrono>
 #include <memory>
 
 using namespace android;
 
+namespace
+{
+
+// The NN runtime prepares a model right after querying its supported operations, so the networks converted by
+// getSupportedOperations are only kept for a short time
+const std::chrono::seconds g_ConvertedNetworkTimeToLive(10);
+
+} // anonymous namespace
+
 namespace armnn_driver
 {
 
@@ -22,6 +32,10 @@ ArmnnDevice::ArmnnDevice(DriverOptions options)
     : m_Runtime(nullptr, nullptr)
     , m_ClTunedParameters(nullptr)
     , m_Options(std::move(options))
+    , m_ConvertedNetworkCache(m_Options.GetConvertedNetworkCacheSize(), g_ConvertedNetworkTimeToLive)
+    , m_LoadedNetworkBudget(static_cast<std::size_t>(m_Options.GetLoadedNetworksBudgetMb()) * 1024 * 1024)
+    , m_ClProgramCache(m_Options.GetComputeDevice() == armnn::Compute::GpuAcc ? m_Options.GetCacheDir() : "")
+    , m_PreparationPool(m_Options.GetNumberOfPrepareThreads(), m_Options.GetMaxQueuedPrepares())
 {
     ALOGV("ArmnnDevice::ArmnnDevice()");
 
@@ -57,6 +71,9 @@ ArmnnDevice::ArmnnDevice(DriverOptions options)
         options.m_EnableGpuProfiling = m_Options.IsGpuProfilingEnabled();
 
         m_Runtime = armnn::IRuntime::Create(options);
+
+        // The runtime initialises OpenCL, which discards any program compiled before
+        m_ClProgramCache.Restore();
     }
     catch (const armnn::ClRuntimeUnavailableException& error)
     {
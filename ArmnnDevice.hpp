@@ -5,7 +5,12 @@
 
 #pragma once
 
+#include "ClProgramCache.hpp"
+#include "ConvertedNetworkCache.hpp"
 #include "DriverOptions.hpp"
+#include "LoadedNetworkBudget.hpp"
+#include "PreparationPool.hpp"
+#include "PreparedNetworkCache.hpp"
 
 #include <armnn/ArmNN.hpp>
 
@@ -22,6 +27,12 @@ protected:
     armnn::IRuntimePtr m_Runtime;
     armnn::IGpuAccTunedParametersPtr m_ClTunedParameters;
     DriverOptions m_Options;
+    PreparedNetworkCache m_NetworkCache;
+    ConvertedNetworkCache m_ConvertedNetworkCache;
+    LoadedNetworkBudget m_LoadedNetworkBudget;
+    ClProgramCache m_ClProgramCache;
+    // Declared last, so that the preparations still queued complete before the other members are destroyed
+    PreparationPool m_PreparationPool;
 };
 
 } // namespace armnn_driver
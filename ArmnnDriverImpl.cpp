@@ -7,7 +7,15 @@
 
 #include "ArmnnDriverImpl.hpp"
 #include "ArmnnPreparedModel.hpp"
+#include "ClProgramCache.hpp"
+#include "ConstTensorStore.hpp"
+#include "ConvertedNetworkCache.hpp"
+#include "LoadedNetworkBudget.hpp"
+#include "ModelHash.hpp"
 #include "ModelToINetworkConverter.hpp"
+#include "PreparationPool.hpp"
+#include "PreparedNetworkCache.hpp"
+#include "RequestBatching.hpp"
 #include "SystemPropertiesUtils.hpp"
 
 #if defined(ARMNN_ANDROID_P)
@@ -18,6 +26,8 @@
 
 #include <log/log.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace android;
 using namespace android::nn;
@@ -26,6 +36,9 @@ using namespace android::hardware;
 namespace
 {
 
+// Serialises the tuning of the CL kernels of the models prepared concurrently, see prepareModel
+std::mutex g_ClTuningMutex;
+
 void NotifyCallbackAndCheck(const sp<IPreparedModelCallback>& callback,
                             ErrorStatus errorStatus,
                             const sp<IPreparedModel>& preparedModelPtr)
@@ -48,98 +61,269 @@ Return<ErrorStatus> FailPrepareModel(ErrorStatus error,
     return error;
 }
 
-} // namespace
-
-namespace armnn_driver
+/// Converts, optimizes and loads a variant of the model that executes several requests at once.
+/// Batching is an optimization, so failures are only logged and the model is then executed one request at a time.
+template<typename HalPolicy>
+BatchedNetwork LoadBatchedNetwork(const armnn::IRuntimePtr& runtime,
+                                  const DriverOptions& options,
+                                  const typename HalPolicy::Model& model,
+                                  bool float32ToFloat16,
+                                  PerformancePreference preference)
 {
+    BatchedNetwork batchedNetwork;
+    const unsigned int batchSize = options.GetMaxBatchSize();
+    if (batchSize <= 1 || !IsModelBatchable(model))
+    {
+        return batchedNetwork;
+    }
+
+    const typename HalPolicy::Model batchedModel = CreateBatchedModel(model, batchSize);
+    set<unsigned int> unsupportedOperations;
+    ModelToINetworkConverter<HalPolicy> modelConverter(options.GetComputeDevice(),
+                                                        batchedModel,
+                                                        unsupportedOperations);
+    if (modelConverter.GetConversionResult() != ConversionResult::Success)
+    {
+        ALOGW("ArmnnDriverImpl::prepareModel: could not convert the batched network, batching is disabled");
+        return batchedNetwork;
+    }
+
+    armnn::OptimizerOptions OptOptions;
+    OptOptions.m_ReduceFp32ToFp16 = float32ToFloat16;
+
+    std::vector<std::string> errMessages;
+    try
+    {
+        armnn::IOptimizedNetworkPtr optNet = armnn::Optimize(*modelConverter.GetINetwork(),
+                                                             {options.GetComputeDevice()},
+                                                             runtime->GetDeviceSpec(),
+                                                             OptOptions,
+                                                             errMessages);
+        armnn::NetworkId netId = 0;
+        armnn::Status loadStatus = armnn::Status::Failure;
+        if (optNet)
+        {
+            std::lock_guard<std::mutex> loadingLock(GetNetworkLoadingMutex());
+            loadStatus = runtime->LoadNetwork(netId, move(optNet));
+        }
+        if (loadStatus != armnn::Status::Success)
+        {
+            ALOGW("ArmnnDriverImpl::prepareModel: could not load the batched network, batching is disabled");
+            return batchedNetwork;
+        }
 
+        batchedNetwork.m_NetworkId = netId;
+        batchedNetwork.m_BatchSize = batchSize;
+        // Waiting for a batch to fill trades latency for throughput, so models prepared for fast single answers
+        // are only batched with the requests already queued
+        batchedNetwork.m_MaxWait   = preference == PerformancePreference::FastSingleAnswer ?
+                                     std::chrono::microseconds(0) :
+                                     std::chrono::microseconds(options.GetMaxBatchWaitMicroseconds());
+    }
+    catch (armnn::Exception& e)
+    {
+        ALOGW("ArmnnDriverImpl::prepareModel: armnn::Exception (%s) caught while preparing the batched network, "
+              "batching is disabled", e.what());
+    }
+
+    return batchedNetwork;
+}
+
+/// Converts, optimizes and loads again the network of a prepared model, after it was unloaded to fit the budget of the
+/// loaded networks. The model was converted successfully when it was prepared, so only running out of memory is
+/// expected to fail.
 template<typename HalPolicy>
-Return<void> ArmnnDriverImpl<HalPolicy>::getSupportedOperations(const armnn::IRuntimePtr& runtime,
-                                                                const DriverOptions& options,
-                                                                const HalModel& model,
-                                                                HalGetSupportedOperations_cb cb)
+bool ReloadNetwork(const armnn::IRuntimePtr& runtime,
+                   const DriverOptions& options,
+                   const typename HalPolicy::Model& model,
+                   bool float32ToFloat16,
+                   PerformancePreference preference,
+                   armnn::NetworkId& netId,
+                   BatchedNetwork& batchedNetwork)
 {
-    ALOGV("ArmnnDriverImpl::getSupportedOperations()");
+    set<unsigned int> unsupportedOperations;
+    ModelToINetworkConverter<HalPolicy> modelConverter(options.GetComputeDevice(), model, unsupportedOperations);
+    if (modelConverter.GetConversionResult() != ConversionResult::Success)
+    {
+        ALOGW("ArmnnDriverImpl: could not convert the model again");
+        return false;
+    }
 
-    vector<bool> result;
+    armnn::OptimizerOptions OptOptions;
+    OptOptions.m_ReduceFp32ToFp16 = float32ToFloat16;
 
-    if (!runtime)
+    std::vector<std::string> errMessages;
+    try
     {
-        cb(ErrorStatus::DEVICE_UNAVAILABLE, result);
-        return Void();
+        armnn::IOptimizedNetworkPtr optNet = armnn::Optimize(*modelConverter.GetINetwork(),
+                                                             {options.GetComputeDevice()},
+                                                             runtime->GetDeviceSpec(),
+                                                             OptOptions,
+                                                             errMessages);
+        armnn::Status loadStatus = armnn::Status::Failure;
+        if (optNet)
+        {
+            std::lock_guard<std::mutex> loadingLock(GetNetworkLoadingMutex());
+            loadStatus = runtime->LoadNetwork(netId, move(optNet));
+        }
+        if (loadStatus != armnn::Status::Success)
+        {
+            ALOGW("ArmnnDriverImpl: could not load the network again");
+            return false;
+        }
     }
-
-    // Run general model validation, if this doesn't pass we shouldn't analyse the model anyway.
-    if (!android::nn::validateModel(model))
+    catch (armnn::Exception& e)
     {
-        cb(ErrorStatus::INVALID_ARGUMENT, result);
-        return Void();
+        ALOGW("ArmnnDriverImpl: armnn::Exception (%s) caught while loading the network again", e.what());
+        return false;
     }
 
-    // Attempt to convert the model to an ArmNN input network (INetwork).
-    ModelToINetworkConverter<HalPolicy> modelConverter(options.GetComputeDevice(),
-                                                        model,
-                                                        options.GetForcedUnsupportedOperations());
+    runtime->GetProfiler(netId)->EnableProfiling(options.IsGpuProfilingEnabled());
+    batchedNetwork = LoadBatchedNetwork<HalPolicy>(runtime, options, model, float32ToFloat16, preference);
+    return true;
+}
 
-    if (modelConverter.GetConversionResult() != ConversionResult::Success
-            && modelConverter.GetConversionResult() != ConversionResult::UnsupportedFeature)
+/// Returns the size in bytes of the constant values of a model, which converting it copies into the network
+template<typename HalModel>
+size_t GetConstantDataSize(const HalModel& model)
+{
+    size_t size = model.operandValues.size();
+    for (const hidl_memory& pool : model.pools)
     {
-        cb(ErrorStatus::GENERAL_FAILURE, result);
-        return Void();
+        size += pool.size();
     }
+    return size;
+}
 
-    // Check each operation if it was converted successfully and copy the flags
-    // into the result (vector<bool>) that we need to return to Android.
-    result.reserve(model.operations.size());
-    for (uint32_t operationIdx = 0; operationIdx < model.operations.size(); operationIdx++)
+/// Adds to a hasher the model and the compute device, which identify the INetwork the model is converted to
+/// @return false if the model cannot be hashed
+template<typename HalModel>
+bool AddConversionToHash(const HalModel& model, const DriverOptions& options, ModelHasher& hasher)
+{
+    if (!AddModelToHash(model, hasher))
     {
-        bool operationSupported = modelConverter.IsOperationSupported(operationIdx);
-        result.push_back(operationSupported);
+        return false;
     }
 
-    cb(ErrorStatus::NONE, result);
-    return Void();
+    hasher.AddValue(options.GetComputeDevice());
+    return true;
 }
 
-template<typename HalPolicy>
-Return<ErrorStatus> ArmnnDriverImpl<HalPolicy>::prepareModel(
-        const armnn::IRuntimePtr& runtime,
-        const armnn::IGpuAccTunedParametersPtr& clTunedParameters,
-        const DriverOptions& options,
-        const HalModel& model,
-        const sp<IPreparedModelCallback>& cb,
-        bool float32ToFloat16)
+/// Computes the hash identifying the INetwork a model is converted to, and the hash identifying the network loaded
+/// for it with the given options, which also depends on how the INetwork is optimized and executed
+/// @return false if the model cannot be hashed, in which case its network is not shared
+template<typename HalModel>
+bool ComputeNetworkHash(const HalModel& model,
+                        const DriverOptions& options,
+                        bool float32ToFloat16,
+                        PerformancePreference preference,
+                        ModelHash& conversionHash,
+                        ModelHash& hash)
 {
-    ALOGV("ArmnnDriverImpl::prepareModel()");
-
-    if (cb.get() == nullptr)
+    ModelHasher hasher;
+    if (!AddConversionToHash(model, options, hasher))
     {
-        ALOGW("ArmnnDriverImpl::prepareModel: Invalid callback passed to prepareModel");
-        return ErrorStatus::INVALID_ARGUMENT;
+        return false;
     }
 
-    if (!runtime)
+    // The model is only hashed once, as hashing its constant tensors takes time for large models
+    ModelHasher conversionHasher = hasher;
+    conversionHash = conversionHasher.GetHash();
+
+    hasher.AddValue(float32ToFloat16);
+    hasher.AddValue(preference);
+    hasher.AddValue(options.GetMaxBatchSize());
+    hasher.AddValue(options.GetMaxBatchWaitMicroseconds());
+    hash = hasher.GetHash();
+    return true;
+}
+
+/// Creates a prepared model executing a network, loading the network again if it was unloaded to fit the budget
+/// @return nullptr if the network could not be loaded
+template<typename HalPolicy>
+ArmnnPreparedModel<HalPolicy>* CreatePreparedModel(const std::shared_ptr<SharedNetwork>& network,
+                                                   const std::shared_ptr<RequestThread<HalPolicy>>& requestThread,
+                                                   const DriverOptions& options,
+                                                   const typename HalPolicy::Model& model,
+                                                   PerformancePreference preference)
+{
+    // Prevents the network from being unloaded while the prepared model looks up its inputs and outputs
+    std::lock_guard<std::mutex> executionLock(network->GetExecutionMutex());
+    if (!network->Load())
     {
-        return FailPrepareModel(ErrorStatus::DEVICE_UNAVAILABLE, "Device unavailable", cb);
+        return nullptr;
     }
 
-    if (!android::nn::validateModel(model))
+    return new ArmnnPreparedModel<HalPolicy>(network,
+                                             model,
+                                             requestThread,
+                                             options.GetRequestInputsAndOutputsDumpDir(),
+                                             options.IsGpuProfilingEnabled(),
+                                             preference,
+                                             options.GetLatencyLogPeriod(),
+                                             options.GetMaxPendingRequestsPerModel(),
+                                             std::chrono::milliseconds(options.GetPendingRequestsTimeoutMs()));
+}
+
+/// Converts, optimizes and loads a validated model, then notifies the client with the prepared model.
+/// Runs on a thread of the preparation pool.
+template<typename HalPolicy>
+void PrepareModelInBackground(const armnn::IRuntimePtr& runtime,
+                              const armnn::IGpuAccTunedParametersPtr& clTunedParameters,
+                              const std::shared_ptr<RequestThread<HalPolicy>>& requestThread,
+                              PreparedNetworkCache& networkCache,
+                              ConvertedNetworkCache& convertedNetworkCache,
+                              LoadedNetworkBudget& loadedNetworkBudget,
+                              ClProgramCache& clProgramCache,
+                              const DriverOptions& options,
+                              const typename HalPolicy::Model& model,
+                              const sp<IPreparedModelCallback>& cb,
+                              bool float32ToFloat16,
+                              PerformancePreference preference)
+{
+    // Clients typically prepare the same model again each time they start, in which case the network loaded
+    // the first time is reused, and has already been warmed up
+    ModelHash conversionHash;
+    ModelHash networkHash;
+    const bool isHashed = ComputeNetworkHash(model, options, float32ToFloat16, preference,
+                                             conversionHash, networkHash);
+    std::shared_ptr<SharedNetwork> network = isHashed ? networkCache.Find(networkHash) : nullptr;
+    if (network)
     {
-        return FailPrepareModel(ErrorStatus::INVALID_ARGUMENT, "Invalid model passed as input", cb);
+        sp<IPreparedModel> preparedModel = CreatePreparedModel(network, requestThread, options, model, preference);
+        if (preparedModel == nullptr)
+        {
+            FailPrepareModel(ErrorStatus::GENERAL_FAILURE, "Network could not be loaded again", cb);
+            return;
+        }
+        NotifyCallbackAndCheck(cb, ErrorStatus::NONE, preparedModel);
+        return;
     }
 
-    // Deliberately ignore any unsupported operations requested by the options -
-    // at this point we're being asked to prepare a model that we've already declared support for
-    // and the operation indices may be different to those in getSupportedOperations anyway.
-    set<unsigned int> unsupportedOperations;
-    ModelToINetworkConverter<HalPolicy> modelConverter(options.GetComputeDevice(),
-                                                        model,
-                                                        unsupportedOperations);
+    PrepareReport report;
 
-    if (modelConverter.GetConversionResult() != ConversionResult::Success)
+    // The NN runtime queries the supported operations of the model just before preparing it,
+    // in which case the model has already been converted
+    armnn::INetworkPtr inputNetwork = isHashed ? convertedNetworkCache.Take(conversionHash)
+                                               : armnn::INetworkPtr(nullptr, nullptr);
+    if (!inputNetwork)
     {
-        FailPrepareModel(ErrorStatus::GENERAL_FAILURE, "ModelToINetworkConverter failed", cb);
-        return ErrorStatus::NONE;
+        // Deliberately ignore any unsupported operations requested by the options -
+        // at this point we're being asked to prepare a model that we've already declared support for
+        // and the operation indices may be different to those in getSupportedOperations anyway.
+        set<unsigned int> unsupportedOperations;
+        ModelToINetworkConverter<HalPolicy> modelConverter(options.GetComputeDevice(),
+                                                            model,
+                                                            unsupportedOperations,
+                                                            ConversionMode::Network,
+                                                            &report);
+
+        if (modelConverter.GetConversionResult() != ConversionResult::Success)
+        {
+            FailPrepareModel(ErrorStatus::GENERAL_FAILURE, "ModelToINetworkConverter failed", cb);
+            return;
+        }
+        inputNetwork = modelConverter.TakeINetwork();
     }
 
     // Optimize the network
@@ -148,9 +332,10 @@ Return<ErrorStatus> ArmnnDriverImpl<HalPolicy>::prepareModel(
     OptOptions.m_ReduceFp32ToFp16 = float32ToFloat16;
 
     std::vector<std::string> errMessages;
+    report.BeginPhase(PreparePhase::Optimize);
     try
     {
-        optNet = armnn::Optimize(*modelConverter.GetINetwork(),
+        optNet = armnn::Optimize(*inputNetwork,
                                  {options.GetComputeDevice()},
                                  runtime->GetDeviceSpec(),
                                  OptOptions,
@@ -161,9 +346,11 @@ Return<ErrorStatus> ArmnnDriverImpl<HalPolicy>::prepareModel(
         stringstream message;
         message << "armnn::Exception (" << e.what() << ") caught from optimize.";
         FailPrepareModel(ErrorStatus::GENERAL_FAILURE, message.str(), cb);
-        return ErrorStatus::NONE;
+        return;
     }
 
+    report.EndPhase();
+
     // Check that the optimized network is valid.
     if (!optNet)
     {
@@ -174,20 +361,23 @@ Return<ErrorStatus> ArmnnDriverImpl<HalPolicy>::prepareModel(
             message << "\n" << msg;
         }
         FailPrepareModel(ErrorStatus::GENERAL_FAILURE, message.str(), cb);
-        return ErrorStatus::NONE;
+        return;
     }
 
     // Export the optimized network graph to a dot file if an output dump directory
     // has been specified in the drivers' arguments.
-    ExportNetworkGraphToDotFile<HalModel>(*optNet, options.GetRequestInputsAndOutputsDumpDir(), model);
+    ExportNetworkGraphToDotFile<typename HalPolicy::Model>(*optNet, options.GetRequestInputsAndOutputsDumpDir(), model);
 
     // Load it into the runtime.
     armnn::NetworkId netId = 0;
+    report.BeginPhase(PreparePhase::LoadNetwork);
     try
     {
+        std::lock_guard<std::mutex> loadingLock(GetNetworkLoadingMutex());
         if (runtime->LoadNetwork(netId, move(optNet)) != armnn::Status::Success)
         {
-            return FailPrepareModel(ErrorStatus::GENERAL_FAILURE, "Network could not be loaded", cb);
+            FailPrepareModel(ErrorStatus::GENERAL_FAILURE, "Network could not be loaded", cb);
+            return;
         }
     }
     catch (armnn::Exception& e)
@@ -195,25 +385,77 @@ Return<ErrorStatus> ArmnnDriverImpl<HalPolicy>::prepareModel(
         stringstream message;
         message << "armnn::Exception (" << e.what()<< ") caught from LoadNetwork.";
         FailPrepareModel(ErrorStatus::GENERAL_FAILURE, message.str(), cb);
-        return ErrorStatus::NONE;
+        return;
+    }
+
+    // Load a network executing several requests at once, if batching is enabled
+    report.BeginPhase(PreparePhase::LoadBatchedNetwork);
+    const BatchedNetwork batchedNetwork = LoadBatchedNetwork<HalPolicy>(runtime,
+                                                                        options,
+                                                                        model,
+                                                                        float32ToFloat16,
+                                                                        preference);
+    report.EndPhase();
+
+    // The network can only be unloaded to fit the budget if it can be loaded again. The model is copied for this,
+    // which is cheap as its large constant tensors are in the memory pools it refers to rather than in the model.
+    SharedNetwork::Loader loader;
+    if (loadedNetworkBudget.IsEnabled())
+    {
+        loader = [&runtime, &options, model, float32ToFloat16, preference](armnn::NetworkId& networkId,
+                                                                            BatchedNetwork& batched)
+        {
+            return ReloadNetwork<HalPolicy>(runtime, options, model, float32ToFloat16, preference, networkId, batched);
+        };
+    }
+
+    // The batched network holds a copy of the constant tensors as well
+    const size_t networkSize = GetConstantDataSize(model) * (batchedNetwork.IsValid() ? 2 : 1);
+    network = make_shared<SharedNetwork>(runtime.get(),
+                                         netId,
+                                         batchedNetwork,
+                                         loadedNetworkBudget,
+                                         networkSize,
+                                         loader);
+
+    // Held until the deferred warm-up completes, in case the client releases the model before
+    sp<ArmnnPreparedModel<HalPolicy>> preparedModel(
+                CreatePreparedModel(network, requestThread, options, model, preference));
+    if (preparedModel == nullptr)
+    {
+        // The network was just loaded, but another preparation may have unloaded it to fit the budget since
+        FailPrepareModel(ErrorStatus::GENERAL_FAILURE,
+                         "Network was unloaded to fit the loaded networks budget and could not be loaded again", cb);
+        return;
     }
 
-    unique_ptr<ArmnnPreparedModel<HalPolicy>> preparedModel(
-                new ArmnnPreparedModel<HalPolicy>(
-                    netId,
-                    runtime.get(),
-                    model,
-                    options.GetRequestInputsAndOutputsDumpDir(),
-                    options.IsGpuProfilingEnabled()));
+    const bool updateTunedParameters = clTunedParameters &&
+        options.GetClTunedParametersMode() == armnn::IGpuAccTunedParameters::Mode::UpdateTunedParameters;
+
+    // Tuning needs an inference, so it always happens before the tuned parameters are saved
+    const WarmUpPolicy warmUpPolicy = updateTunedParameters ? WarmUpPolicy::Always : options.GetWarmUpPolicy();
+
+    // Tuning updates the parameters shared by every network, so the models being prepared concurrently
+    // are tuned and the parameters saved one model at a time
+    std::unique_lock<std::mutex> tuningLock(g_ClTuningMutex, std::defer_lock);
+    if (updateTunedParameters)
+    {
+        tuningLock.lock();
+    }
 
     // Run a single 'dummy' inference of the model. This means that CL kernels will get compiled (and tuned if
     // this is enabled) before the first 'real' inference which removes the overhead of the first inference.
-    preparedModel->ExecuteWithDummyInputs();
+    if (warmUpPolicy == WarmUpPolicy::Always)
+    {
+        report.BeginPhase(PreparePhase::WarmUp);
+        preparedModel->ExecuteWithDummyInputs();
+        report.EndPhase();
+    }
 
-    if (clTunedParameters &&
-        options.GetClTunedParametersMode() == armnn::IGpuAccTunedParameters::Mode::UpdateTunedParameters)
+    if (updateTunedParameters)
     {
         // Now that we've done one inference the CL kernel parameters will have been tuned, so save the updated file.
+        report.BeginPhase(PreparePhase::SaveTunedParameters);
         try
         {
             clTunedParameters->Save(options.GetClTunedParametersFile().c_str());
@@ -223,9 +465,155 @@ Return<ErrorStatus> ArmnnDriverImpl<HalPolicy>::prepareModel(
             ALOGE("ArmnnDriverImpl::prepareModel: Failed to save CL tuned parameters file '%s': %s",
                   options.GetClTunedParametersFile().c_str(), error.what());
         }
+        report.EndPhase();
+    }
+    tuningLock.unlock();
+
+    // Keep the OpenCL programs compiled for the network, so that they are not compiled again after a restart
+    clProgramCache.Save();
+
+    if (isHashed)
+    {
+        networkCache.Insert(networkHash, network);
+    }
+
+    NotifyCallbackAndCheck(cb, ErrorStatus::NONE, preparedModel);
+
+    // The client may already be executing requests, in which case the warm-up is skipped
+    if (warmUpPolicy == WarmUpPolicy::Deferred)
+    {
+        report.BeginPhase(PreparePhase::WarmUp);
+        preparedModel->ExecuteWithDummyInputs();
+        report.EndPhase();
+    }
+
+    // Reported once the client is notified, so that it does not wait for the report to be written
+    ALOGI("ArmnnDriverImpl::prepareModel: prepared network %d: %s, %zu KB of constant tensor permutes avoided so far",
+          netId, report.GetSummary().c_str(), GetConstTensorStore().GetNumReusedPermutedBytes() / 1024);
+    report.DumpJson(options.GetRequestInputsAndOutputsDumpDir(), netId);
+}
+
+} // namespace
+
+namespace armnn_driver
+{
+
+template<typename HalPolicy>
+Return<void> ArmnnDriverImpl<HalPolicy>::getSupportedOperations(const armnn::IRuntimePtr& runtime,
+                                                                ConvertedNetworkCache& convertedNetworkCache,
+                                                                const DriverOptions& options,
+                                                                const HalModel& model,
+                                                                HalGetSupportedOperations_cb cb)
+{
+    ALOGV("ArmnnDriverImpl::getSupportedOperations()");
+
+    vector<bool> result;
+
+    if (!runtime)
+    {
+        cb(ErrorStatus::DEVICE_UNAVAILABLE, result);
+        return Void();
+    }
+
+    // Run general model validation, if this doesn't pass we shouldn't analyse the model anyway.
+    if (!android::nn::validateModel(model))
+    {
+        cb(ErrorStatus::INVALID_ARGUMENT, result);
+        return Void();
     }
 
-    NotifyCallbackAndCheck(cb, ErrorStatus::NONE, preparedModel.release());
+    // Converting a model copies its constant tensors into the network, which is only worth it if the network can be
+    // kept for prepareModel. Otherwise a dry run finds the supported operations without copying the tensors.
+    const bool keepNetwork = convertedNetworkCache.IsEnabled() &&
+        GetConstantDataSize(model) <= static_cast<size_t>(options.GetMaxConvertedNetworkMb()) * 1024 * 1024;
+
+    // Attempt to convert the model to an ArmNN input network (INetwork).
+    ModelToINetworkConverter<HalPolicy> modelConverter(options.GetComputeDevice(),
+                                                        model,
+                                                        options.GetForcedUnsupportedOperations(),
+                                                        keepNetwork ? ConversionMode::Network
+                                                                    : ConversionMode::DryRun);
+
+    if (modelConverter.GetConversionResult() != ConversionResult::Success
+            && modelConverter.GetConversionResult() != ConversionResult::UnsupportedFeature)
+    {
+        cb(ErrorStatus::GENERAL_FAILURE, result);
+        return Void();
+    }
+
+    // Check each operation if it was converted successfully and copy the flags
+    // into the result (vector<bool>) that we need to return to Android.
+    result.reserve(model.operations.size());
+    for (uint32_t operationIdx = 0; operationIdx < model.operations.size(); operationIdx++)
+    {
+        bool operationSupported = modelConverter.IsOperationSupported(operationIdx);
+        result.push_back(operationSupported);
+    }
+
+    // Keep the network of a fully supported model for prepareModel, which the NN runtime calls next
+    ModelHasher hasher;
+    if (keepNetwork && modelConverter.GetConversionResult() == ConversionResult::Success
+            && AddConversionToHash(model, options, hasher))
+    {
+        convertedNetworkCache.Insert(hasher.GetHash(), modelConverter.TakeINetwork());
+    }
+
+    cb(ErrorStatus::NONE, result);
+    return Void();
+}
+
+template<typename HalPolicy>
+Return<ErrorStatus> ArmnnDriverImpl<HalPolicy>::prepareModel(
+        const armnn::IRuntimePtr& runtime,
+        const armnn::IGpuAccTunedParametersPtr& clTunedParameters,
+        const std::shared_ptr<RequestThread<HalPolicy>>& requestThread,
+        PreparedNetworkCache& networkCache,
+        ConvertedNetworkCache& convertedNetworkCache,
+        LoadedNetworkBudget& loadedNetworkBudget,
+        ClProgramCache& clProgramCache,
+        PreparationPool& preparationPool,
+        const DriverOptions& options,
+        const HalModel& model,
+        const sp<IPreparedModelCallback>& cb,
+        bool float32ToFloat16,
+        PerformancePreference preference)
+{
+    ALOGV("ArmnnDriverImpl::prepareModel()");
+
+    if (cb.get() == nullptr)
+    {
+        ALOGW("ArmnnDriverImpl::prepareModel: Invalid callback passed to prepareModel");
+        return ErrorStatus::INVALID_ARGUMENT;
+    }
+
+    if (!runtime)
+    {
+        return FailPrepareModel(ErrorStatus::DEVICE_UNAVAILABLE, "Device unavailable", cb);
+    }
+
+    if (!android::nn::validateModel(model))
+    {
+        return FailPrepareModel(ErrorStatus::INVALID_ARGUMENT, "Invalid model passed as input", cb);
+    }
+
+    // The client waits on the callback, so the binder thread is released before the model is prepared.
+    // The model is copied, as the client may release it once prepareModel returns.
+    preparationPool.Post([=, &runtime, &clTunedParameters, &networkCache, &convertedNetworkCache, &loadedNetworkBudget,
+                          &clProgramCache, &options]()
+    {
+        PrepareModelInBackground<HalPolicy>(runtime,
+                                            clTunedParameters,
+                                            requestThread,
+                                            networkCache,
+                                            convertedNetworkCache,
+                                            loadedNetworkBudget,
+                                            clProgramCache,
+                                            options,
+                                            model,
+                                            cb,
+                                            float32ToFloat16,
+                                            preference);
+    });
 
     return ErrorStatus::NONE;
 }
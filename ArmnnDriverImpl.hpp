@@ -9,9 +9,29 @@
 
 #include <HalInterfaces.h>
 
+#include <memory>
+
 namespace armnn_driver
 {
 
+template<typename HalVersion>
+class RequestThread;
+
+class ClProgramCache;
+class ConvertedNetworkCache;
+class LoadedNetworkBudget;
+class PreparationPool;
+class PreparedNetworkCache;
+
+/// What a model is prepared to be good at. This mirrors V1_1::ExecutionPreference, which HAL 1.0 does not have:
+/// models prepared through HAL 1.0 use FastSingleAnswer, the default preference of the NN runtime.
+enum class PerformancePreference
+{
+    LowPower,               // minimize the power consumption, e.g. by using fewer threads
+    FastSingleAnswer,       // minimize the latency of single requests, they overtake the other requests
+    SustainedSpeed          // maximize the throughput of successive requests
+};
+
 template<typename HalPolicy>
 class ArmnnDriverImpl
 {
@@ -21,6 +41,7 @@ public:
 
     static Return<void> getSupportedOperations(
             const armnn::IRuntimePtr& runtime,
+            ConvertedNetworkCache& convertedNetworkCache,
             const DriverOptions& options,
             const HalModel& model,
             HalGetSupportedOperations_cb);
@@ -28,10 +49,17 @@ public:
     static Return<ErrorStatus> prepareModel(
             const armnn::IRuntimePtr& runtime,
             const armnn::IGpuAccTunedParametersPtr& clTunedParameters,
+            const std::shared_ptr<RequestThread<HalPolicy>>& requestThread,
+            PreparedNetworkCache& networkCache,
+            ConvertedNetworkCache& convertedNetworkCache,
+            LoadedNetworkBudget& loadedNetworkBudget,
+            ClProgramCache& clProgramCache,
+            PreparationPool& preparationPool,
             const DriverOptions& options,
             const HalModel& model,
             const android::sp<IPreparedModelCallback>& cb,
-            bool float32ToFloat16 = false);
+            bool float32ToFloat16 = false,
+            PerformancePreference preference = PerformancePreference::FastSingleAnswer);
 
     static Return<DeviceStatus> getStatus();
 };
@@ -20,6 +20,8 @@
 
 #include <cassert>
 #include <cinttypes>
+#include <cstring>
+#include <mutex>
 
 using namespace android;
 
@@ -28,19 +30,28 @@ namespace
 using namespace armnn_driver;
 
 void NotifyCallbackAndCheck(const ::android::sp<IExecutionCallback>& callback, ErrorStatus errorStatus,
-                            std::string callingFunction)
+                            const char* callingFunction)
 {
     Return<void> returned = callback->notify(errorStatus);
     // This check is required, if the callback fails and it isn't checked it will bring down the service
     if (!returned.isOk())
     {
         ALOGE("ArmnnDriver::%s: hidl callback failed to return properly: %s",
-            callingFunction.c_str(), returned.description().c_str());
+            callingFunction, returned.description().c_str());
     }
 }
 
-bool ValidateRequestArgument(const RequestArgument& requestArg, const armnn::TensorInfo& tensorInfo)
+bool ValidateRequestArgument(const RequestArgument& requestArg,
+                             const armnn::TensorInfo& tensorInfo,
+                             unsigned int numBytes)
 {
+    if (requestArg.location.length < numBytes)
+    {
+        ALOGE("Request argument is too small (request argument: %u bytes, expected: %u bytes)",
+              requestArg.location.length, numBytes);
+        return false;
+    }
+
     if (requestArg.dimensions.size() != 0)
     {
         if (requestArg.dimensions.size() != tensorInfo.GetNumDimensions())
@@ -66,9 +77,10 @@ bool ValidateRequestArgument(const RequestArgument& requestArg, const armnn::Ten
 
 armnn::Tensor GetTensorForRequestArgument(const RequestArgument& requestArg,
     const armnn::TensorInfo& tensorInfo,
-    const std::vector<::android::nn::RunTimePoolInfo>& requestPools)
+    unsigned int numBytes,
+    const std::vector<std::shared_ptr<::android::nn::RunTimePoolInfo>>& requestPools)
 {
-    if (!ValidateRequestArgument(requestArg, tensorInfo))
+    if (!ValidateRequestArgument(requestArg, tensorInfo, numBytes))
     {
         return armnn::Tensor();
     }
@@ -76,6 +88,12 @@ armnn::Tensor GetTensorForRequestArgument(const RequestArgument& requestArg,
     return armnn::Tensor(tensorInfo, GetMemoryFromPool(requestArg.location, requestPools));
 }
 
+// The maximum number of mapped memory pools kept by each prepared model
+const std::size_t g_MemoryPoolCacheCapacity = 8;
+
+// Numbers the prepared models, see ArmnnPreparedModel::GetPreparedModelId
+std::atomic<unsigned int> g_NextPreparedModelId(0);
+
 inline std::string BuildTensorName(const char* tensorNamePrefix, std::size_t index)
 {
     return tensorNamePrefix + std::to_string(index);
@@ -88,17 +106,16 @@ using namespace android::hardware;
 namespace armnn_driver
 {
 
-template<typename HalVersion>
-RequestThread<HalVersion> ArmnnPreparedModel<HalVersion>::m_RequestThread;
-
 template<typename HalVersion>
 template <typename TensorBindingCollection>
 void ArmnnPreparedModel<HalVersion>::DumpTensorsIfRequired(char const* tensorNamePrefix,
+                                                           uint32_t requestIndex,
                                                            const TensorBindingCollection& tensorBindings)
 {
     if (!m_RequestInputsAndOutputsDumpDir.empty())
     {
-        const std::string requestName = boost::str(boost::format("%1%_%2%.dump") % m_NetworkId % m_RequestCount);
+        const std::string requestName =
+            boost::str(boost::format("%1%_%2%_%3%.dump") % m_NetworkId % m_PreparedModelId % requestIndex);
         for (std::size_t i = 0u; i < tensorBindings.size(); ++i)
         {
             DumpTensor(m_RequestInputsAndOutputsDumpDir,
@@ -110,184 +127,596 @@ void ArmnnPreparedModel<HalVersion>::DumpTensorsIfRequired(char const* tensorNam
 }
 
 template<typename HalVersion>
-ArmnnPreparedModel<HalVersion>::ArmnnPreparedModel(armnn::NetworkId networkId,
-                                                   armnn::IRuntime* runtime,
+ArmnnPreparedModel<HalVersion>::ArmnnPreparedModel(const std::shared_ptr<SharedNetwork>& network,
                                                    const HalModel& model,
+                                                   const std::shared_ptr<RequestThread<HalVersion>>& requestThread,
                                                    const std::string& requestInputsAndOutputsDumpDir,
-                                                   const bool gpuProfilingEnabled)
-    : m_NetworkId(networkId)
-    , m_Runtime(runtime)
-    , m_Model(model)
+                                                   const bool gpuProfilingEnabled,
+                                                   const PerformancePreference preference,
+                                                   const unsigned int latencyLogPeriod,
+                                                   const unsigned int maxPendingRequests,
+                                                   const std::chrono::milliseconds pendingRequestsTimeout)
+    : m_Network(network)
+    , m_NetworkId(network->GetNetworkId())
+    , m_PreparedModelId(g_NextPreparedModelId++)
+    , m_Runtime(network->GetRuntime())
+    , m_Metadata(model)
+    , m_Preference(preference)
+    , m_RequestThread(requestThread)
+    , m_RequestThreadWorker(requestThread->AssignWorker(preference))
+    , m_ExecutionMutex(network->GetExecutionMutex())
+    , m_NumPostedRequests(0)
+    , m_PendingRequestLimit(maxPendingRequests)
+    , m_PendingRequestsTimeout(pendingRequestsTimeout)
+    , m_MemoryPoolCache(g_MemoryPoolCacheCapacity)
+    , m_ClientDied(false)
+    , m_NumDroppedRequests(0)
+    , m_LatencyStats(latencyLogPeriod)
+    , m_BatchedNetwork(network->GetBatchedNetwork())
     , m_RequestCount(0)
     , m_RequestInputsAndOutputsDumpDir(requestInputsAndOutputsDumpDir)
     , m_GpuProfilingEnabled(gpuProfilingEnabled)
 {
     // Enable profiling if required.
     m_Runtime->GetProfiler(m_NetworkId)->EnableProfiling(m_GpuProfilingEnabled);
+
+    // Look up the bindings of the network once, rather than for every request
+    m_InputBindings.reserve(m_Metadata.m_InputsAndOutputs.inputIndexes.size());
+    for (unsigned int i = 0; i < m_Metadata.m_InputsAndOutputs.inputIndexes.size(); i++)
+    {
+        m_InputBindings.emplace_back(m_Runtime->GetInputTensorInfo(m_NetworkId, i));
+    }
+
+    m_OutputBindings.reserve(m_Metadata.m_InputsAndOutputs.outputIndexes.size());
+    for (unsigned int i = 0; i < m_Metadata.m_InputsAndOutputs.outputIndexes.size(); i++)
+    {
+        m_OutputBindings.emplace_back(m_Runtime->GetOutputTensorInfo(m_NetworkId, i));
+    }
+
+    if (m_BatchedNetwork.IsValid() && !InitializeBatching())
+    {
+        // The batched network stays loaded until the shared network is released, as other models may use it
+        ALOGW("ArmnnPreparedModel: the batched network does not match the model, batching is disabled");
+        m_BatchedNetwork = BatchedNetwork();
+    }
+}
+
+template<typename HalVersion>
+bool ArmnnPreparedModel<HalVersion>::InitializeBatching()
+{
+    const unsigned int batchSize = m_BatchedNetwork.m_BatchSize;
+
+    m_BatchInputStorage.resize(m_InputBindings.size());
+    m_BatchInputTensors.reserve(m_InputBindings.size());
+    for (unsigned int i = 0; i < m_InputBindings.size(); i++)
+    {
+        const armnn::TensorInfo batchedInfo = m_Runtime->GetInputTensorInfo(m_BatchedNetwork.m_NetworkId, i);
+        if (batchedInfo.GetNumBytes() != batchSize * m_InputBindings[i].m_NumBytes)
+        {
+            return false;
+        }
+        m_BatchInputStorage[i].resize(batchedInfo.GetNumBytes());
+        m_BatchInputTensors.emplace_back(i, armnn::ConstTensor(batchedInfo, m_BatchInputStorage[i].data()));
+    }
+
+    m_BatchOutputStorage.resize(m_OutputBindings.size());
+    m_BatchOutputTensors.reserve(m_OutputBindings.size());
+    for (unsigned int i = 0; i < m_OutputBindings.size(); i++)
+    {
+        const armnn::TensorInfo batchedInfo = m_Runtime->GetOutputTensorInfo(m_BatchedNetwork.m_NetworkId, i);
+        if (batchedInfo.GetNumBytes() != batchSize * m_OutputBindings[i].m_NumBytes)
+        {
+            return false;
+        }
+        m_BatchOutputStorage[i].resize(batchedInfo.GetNumBytes());
+        m_BatchOutputTensors.emplace_back(i, armnn::Tensor(batchedInfo, m_BatchOutputStorage[i].data()));
+    }
+
+    return true;
 }
 
 template<typename HalVersion>
 ArmnnPreparedModel<HalVersion>::~ArmnnPreparedModel()
 {
-    // Get a hold of the profiler used by this model.
-    std::shared_ptr<armnn::IProfiler> profiler = m_Runtime->GetProfiler(m_NetworkId);
+    // The request thread may still hold requests of this model, e.g. those of a dead client it is dropping
+    {
+        std::unique_lock<std::mutex> lock(m_PostedRequestsMutex);
+        m_PostedRequestsDone.wait(lock, [this] { return m_NumPostedRequests == 0; });
+    }
+
+    // The death recipient refers to the memory pool cache, which is about to be destroyed
+    if (m_ClientLink != nullptr)
+    {
+        m_ClientLink->unlinkToDeath(m_ClientDeathRecipient);
+    }
 
-    // Unload the network associated with this model.
-    m_Runtime->UnloadNetwork(m_NetworkId);
+    // Get a hold of the profiler used by this model, unless the network was unloaded to fit the budget.
+    // The network itself is unloaded with m_Network, once no other model shares it.
+    std::shared_ptr<armnn::IProfiler> profiler;
+    {
+        std::lock_guard<std::mutex> executionLock(m_ExecutionMutex);
+        if (m_Network->IsLoaded())
+        {
+            profiler = m_Runtime->GetProfiler(m_Network->GetNetworkId());
+        }
+    }
 
     // Dump the profiling info to a file if required.
-    DumpJsonProfilingIfRequired(m_GpuProfilingEnabled, m_RequestInputsAndOutputsDumpDir, m_NetworkId, profiler.get());
+    if (profiler)
+    {
+        DumpJsonProfilingIfRequired(m_GpuProfilingEnabled, m_RequestInputsAndOutputsDumpDir, m_NetworkId,
+                                    m_PreparedModelId, profiler.get());
+    }
+
+    DumpLatencyStats();
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::DumpLatencyStats() const
+{
+    m_LatencyStats.DumpJson(m_RequestInputsAndOutputsDumpDir, m_NetworkId, m_PreparedModelId);
 }
 
 template<typename HalVersion>
 Return<ErrorStatus> ArmnnPreparedModel<HalVersion>::execute(const Request& request,
                                                             const ::android::sp<IExecutionCallback>& callback)
 {
-    ALOGV("ArmnnPreparedModel::execute(): %s", GetModelSummary(m_Model).c_str());
-    m_RequestCount++;
+    ALOGV("ArmnnPreparedModel::execute(): %s", m_Metadata.m_Summary.c_str());
+    RequestTimings timings;
+    timings.Record(RequestStage::Received);
+    const uint32_t requestIndex = ++m_RequestCount;
 
     if (callback.get() == nullptr) {
         ALOGE("ArmnnPreparedModel::execute invalid callback passed");
         return ErrorStatus::INVALID_ARGUMENT;
     }
 
-    if (!android::nn::validateRequest(request, m_Model))
+    if (!android::nn::validateRequest(request, m_Metadata.m_InputsAndOutputs))
     {
         NotifyCallbackAndCheck(callback, ErrorStatus::INVALID_ARGUMENT, "ArmnnPreparedModel::execute");
         return ErrorStatus::INVALID_ARGUMENT;
     }
+    timings.Record(RequestStage::Validated);
 
     if (!m_RequestInputsAndOutputsDumpDir.empty())
     {
         ALOGD("Dumping inputs and outputs for request %" PRIuPTR, reinterpret_cast<std::uintptr_t>(callback.get()));
     }
 
-    // allocate the tensors on the heap, as they are passed to the request thread
-    auto pInputTensors = std::make_shared<armnn::InputTensors>();
-    auto pOutputTensors = std::make_shared<armnn::OutputTensors>();
+    // Reject the request before mapping its memory if too many requests are already pending
+    if (!AdmitRequest())
+    {
+        ALOGW("ArmnnPreparedModel::execute: too many pending requests, the request is rejected");
+        NotifyCallbackAndCheck(callback, ErrorStatus::DEVICE_UNAVAILABLE, "ArmnnPreparedModel::execute");
+        return ErrorStatus::DEVICE_UNAVAILABLE;
+    }
+
+    LinkToClientDeath(callback);
+
+    // take a recycled slot to hold the tensors and memory pools, as they are passed to the request thread
+    RequestSlot* slot = m_RequestSlots.Acquire(request.pools.size(), request.inputs.size(), request.outputs.size());
+    slot->m_Timings = timings;
+    slot->m_RequestIndex = requestIndex;
+    const ErrorStatus status = BindRequest(request, slot);
+    if (status != ErrorStatus::NONE)
+    {
+        m_RequestSlots.Release(slot);
+        CompleteRequest();
+        NotifyCallbackAndCheck(callback, status, "ArmnnPreparedModel::execute");
+        return status;
+    }
+
+    slot->m_Callback = callback;
+    PostRequest(slot);
+
+    return ErrorStatus::NONE; // successfully queued
+}
+
+template<typename HalVersion>
+bool ArmnnPreparedModel<HalVersion>::AdmitRequest()
+{
+    const PendingRequestLimit::Clock::time_point deadline = PendingRequestLimit::Clock::now() + m_PendingRequestsTimeout;
+
+    // Admit the request for the model first, so that a model with too many requests does not hold back the others
+    if (!m_PendingRequestLimit.Acquire(deadline))
+    {
+        return false;
+    }
+    if (!m_RequestThread->GetPendingRequestLimit().Acquire(deadline))
+    {
+        m_PendingRequestLimit.Release();
+        return false;
+    }
+    return true;
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::CompleteRequest()
+{
+    m_RequestThread->GetPendingRequestLimit().Release();
+    m_PendingRequestLimit.Release();
+}
 
-    // map the memory pool into shared pointers
-    // use a shared memory pools vector on the heap, as it is passed to the request thread
-    auto pMemPools = std::make_shared<std::vector<android::nn::RunTimePoolInfo>>();
-    if (!setRunTimePoolInfosFromHidlMemories(pMemPools.get(), request.pools))
+template<typename HalVersion>
+ErrorStatus ArmnnPreparedModel<HalVersion>::BindRequest(const Request& request, RequestSlot* slot)
+{
+    // map the memory pools into the slot, reusing the pools mapped for previous requests
+    if (!m_MemoryPoolCache.GetRunTimePoolInfos(request.pools, slot->m_MemPools))
     {
-        NotifyCallbackAndCheck(callback, ErrorStatus::GENERAL_FAILURE, "ArmnnPreparedModel::execute");
         return ErrorStatus::GENERAL_FAILURE;
     }
 
+    if (request.inputs.size() != m_InputBindings.size() || request.outputs.size() != m_OutputBindings.size())
+    {
+        ALOGE("Cannot execute request. Mismatched number of inputs or outputs");
+        return ErrorStatus::INVALID_ARGUMENT;
+    }
+
     // add the inputs and outputs with their data
     try
     {
-        pInputTensors->reserve(request.inputs.size());
         for (unsigned int i = 0; i < request.inputs.size(); i++)
         {
             const auto& inputArg = request.inputs[i];
 
-            const armnn::TensorInfo inputTensorInfo = m_Runtime->GetInputTensorInfo(m_NetworkId, i);
-            const armnn::Tensor inputTensor = GetTensorForRequestArgument(inputArg, inputTensorInfo, *pMemPools);
+            const TensorBinding& binding = m_InputBindings[i];
+            const armnn::Tensor inputTensor =
+                GetTensorForRequestArgument(inputArg, binding.m_TensorInfo, binding.m_NumBytes, slot->m_MemPools);
             if (inputTensor.GetMemoryArea() == nullptr)
             {
                 ALOGE("Cannot execute request. Error converting request input %u to tensor", i);
                 return ErrorStatus::GENERAL_FAILURE;
             }
 
-            pInputTensors->emplace_back(i, inputTensor);
+            slot->m_InputTensors.emplace_back(i, inputTensor);
         }
 
-        pOutputTensors->reserve(request.outputs.size());
         for (unsigned int i = 0; i < request.outputs.size(); i++)
         {
             const auto& outputArg = request.outputs[i];
 
-            const armnn::TensorInfo outputTensorInfo = m_Runtime->GetOutputTensorInfo(m_NetworkId, i);
-            const armnn::Tensor outputTensor = GetTensorForRequestArgument(outputArg, outputTensorInfo, *pMemPools);
+            const TensorBinding& binding = m_OutputBindings[i];
+            const armnn::Tensor outputTensor =
+                GetTensorForRequestArgument(outputArg, binding.m_TensorInfo, binding.m_NumBytes, slot->m_MemPools);
             if (outputTensor.GetMemoryArea() == nullptr)
             {
                 ALOGE("Cannot execute request. Error converting request output %u to tensor", i);
                 return ErrorStatus::GENERAL_FAILURE;
             }
 
-            pOutputTensors->emplace_back(i, outputTensor);
+            slot->m_OutputTensors.emplace_back(i, outputTensor);
         }
     }
     catch (armnn::Exception& e)
     {
         ALOGW("armnn::Exception caught while preparing for EnqueueWorkload: %s", e.what());
-        NotifyCallbackAndCheck(callback, ErrorStatus::GENERAL_FAILURE, "ArmnnPreparedModel::execute");
         return ErrorStatus::GENERAL_FAILURE;
     }
 
-    ALOGV("ArmnnPreparedModel::execute(...) before PostMsg");
+    GetOutputPoolIndexes(request, slot->m_OutputPoolIndexes);
+    slot->m_Timings.Record(RequestStage::PoolsMapped);
+    return ErrorStatus::NONE;
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::PostRequest(RequestSlot* slot)
+{
+    ALOGV("ArmnnPreparedModel::PostRequest(...) before PostMsg");
     // post the request for asynchronous execution
-    m_RequestThread.PostMsg(this, pMemPools, pInputTensors, pOutputTensors, callback);
-    ALOGV("ArmnnPreparedModel::execute(...) after PostMsg");
+    {
+        std::lock_guard<std::mutex> lock(m_PostedRequestsMutex);
+        ++m_NumPostedRequests;
+    }
+    slot->m_Timings.Record(RequestStage::Enqueued);
+    m_RequestThread->PostMsg(m_RequestThreadWorker, this, slot);
+    ALOGV("ArmnnPreparedModel::PostRequest(...) after PostMsg");
+}
 
-    return ErrorStatus::NONE; // successfully queued
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::FinishPostedRequests(unsigned int numRequests)
+{
+    std::lock_guard<std::mutex> lock(m_PostedRequestsMutex);
+    m_NumPostedRequests -= numRequests;
+    if (m_NumPostedRequests == 0)
+    {
+        m_PostedRequestsDone.notify_all();
+    }
 }
 
 template<typename HalVersion>
-void ArmnnPreparedModel<HalVersion>::ExecuteGraph(
-        std::shared_ptr<std::vector<::android::nn::RunTimePoolInfo>>& pMemPools,
-        std::shared_ptr<armnn::InputTensors>& pInputTensors,
-        std::shared_ptr<armnn::OutputTensors>& pOutputTensors,
-        const ::android::sp<IExecutionCallback>& callback)
+ErrorStatus ArmnnPreparedModel<HalVersion>::RunRequest(RequestSlot* slot)
 {
-    ALOGV("ArmnnPreparedModel::ExecuteGraph(...)");
+    // The network may have been unloaded to fit the budget since the previous request
+    if (!m_Network->Load())
+    {
+        return ErrorStatus::GENERAL_FAILURE;
+    }
 
-    DumpTensorsIfRequired("Input", *pInputTensors);
+    DumpTensorsIfRequired("Input", slot->m_RequestIndex, slot->m_InputTensors);
 
     // run it
+    slot->m_Timings.Record(RequestStage::WorkloadStarted);
     try
     {
-        m_Runtime->EnqueueWorkload(m_NetworkId, *pInputTensors, *pOutputTensors);
+        m_Runtime->EnqueueWorkload(m_Network->GetNetworkId(), slot->m_InputTensors, slot->m_OutputTensors);
     }
     catch (armnn::Exception& e)
     {
         ALOGW("armnn::Exception caught from EnqueueWorkload: %s", e.what());
-        NotifyCallbackAndCheck(callback, ErrorStatus::GENERAL_FAILURE, "ArmnnPreparedModel::ExecuteGraph");
-        return;
+        return ErrorStatus::GENERAL_FAILURE;
     }
+    slot->m_Timings.Record(RequestStage::WorkloadFinished);
 
-    DumpTensorsIfRequired("Output", *pOutputTensors);
+    DumpTensorsIfRequired("Output", slot->m_RequestIndex, slot->m_OutputTensors);
 
+    CommitOutputs(slot);
+    slot->m_Timings.Record(RequestStage::Committed);
+
+    return ErrorStatus::NONE;
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::CommitOutputs(RequestSlot* slot)
+{
     // Commit output buffers.
-    // Note that we update *all* pools, even if they aren't actually used as outputs -
-    // this is simpler and is what the CpuExecutor does.
-    for (android::nn::RunTimePoolInfo& pool : *pMemPools)
+    // Only the pools written by the outputs are updated, input pools can be large and do not need flushing.
+    for (uint32_t poolIndex : slot->m_OutputPoolIndexes)
     {
-        pool.update();
+        slot->m_MemPools[poolIndex]->update();
     }
+}
 
-    NotifyCallbackAndCheck(callback, ErrorStatus::NONE, "ExecuteGraph");
+template<typename HalVersion>
+bool ArmnnPreparedModel<HalVersion>::DropRequestIfClientDied(RequestSlot* slot)
+{
+    if (!m_ClientDied.load())
+    {
+        return false;
+    }
+
+    // Nobody will read the outputs, and notifying a dead callback fails
+    ++m_NumDroppedRequests;
+    m_RequestSlots.Release(slot);
+    CompleteRequest();
+    return true;
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::ExecuteGraph(RequestSlot* slot)
+{
+    ALOGV("ArmnnPreparedModel::ExecuteGraph(...)");
+
+    if (DropRequestIfClientDied(slot))
+    {
+        ALOGV("ArmnnPreparedModel::ExecuteGraph(...) dropped a request of a dead client");
+        FinishPostedRequests(1);
+        return;
+    }
+
+    // The slot is returned to the pool before notifying the client, so that a client waiting for this request
+    // to complete before submitting the next one finds it free
+    const ::android::sp<IExecutionCallback> callback = slot->m_Callback;
+
+    ErrorStatus status;
+    {
+        std::lock_guard<std::mutex> executionLock(m_ExecutionMutex);
+        status = RunRequest(slot);
+    }
+
+    RequestTimings timings = slot->m_Timings;
+    m_RequestSlots.Release(slot);
+    CompleteRequest();
+    NotifyCallbackAndCheck(callback, status, "ArmnnPreparedModel::ExecuteGraph");
+
+    if (status == ErrorStatus::NONE)
+    {
+        timings.Record(RequestStage::Notified);
+        m_LatencyStats.Add(timings);
+    }
+
+    // The client may release the model as soon as it is notified
+    FinishPostedRequests(1);
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::ExecuteGraphBatch(RequestSlot* const* slots, unsigned int numSlots)
+{
+    if (numSlots == 1)
+    {
+        ExecuteGraph(slots[0]);
+        return;
+    }
+
+    ALOGV("ArmnnPreparedModel::ExecuteGraphBatch(%u)", numSlots);
+    assert(numSlots <= m_BatchedNetwork.m_BatchSize);
+
+    if (m_ClientDied.load())
+    {
+        // The requests of the dead client are dropped one by one
+        for (unsigned int s = 0; s < numSlots; s++)
+        {
+            ExecuteGraph(slots[s]);
+        }
+        return;
+    }
+
+    ErrorStatus status = ErrorStatus::NONE;
+    {
+        std::unique_lock<std::mutex> executionLock(m_ExecutionMutex);
+
+        // The batched network is loaded again with the network, and may fail to load on its own
+        if (!m_Network->Load() || !m_Network->GetBatchedNetwork().IsValid())
+        {
+            executionLock.unlock();
+            for (unsigned int s = 0; s < numSlots; s++)
+            {
+                ExecuteGraph(slots[s]);
+            }
+            return;
+        }
+
+        // Stack the inputs of the requests. When the batch is not full the remaining elements are left as they are,
+        // the batched network computes them but their outputs are discarded.
+        for (unsigned int i = 0; i < m_InputBindings.size(); i++)
+        {
+            const unsigned int numBytes = m_InputBindings[i].m_NumBytes;
+            for (unsigned int s = 0; s < numSlots; s++)
+            {
+                std::memcpy(m_BatchInputStorage[i].data() + s * numBytes,
+                            slots[s]->m_InputTensors[i].second.GetMemoryArea(),
+                            numBytes);
+            }
+        }
+
+        DumpTensorsIfRequired("Input", slots[0]->m_RequestIndex, m_BatchInputTensors);
+
+        const RequestTimings::Clock::time_point workloadStarted = RequestTimings::Clock::now();
+        try
+        {
+            m_Runtime->EnqueueWorkload(m_Network->GetBatchedNetwork().m_NetworkId,
+                                       m_BatchInputTensors,
+                                       m_BatchOutputTensors);
+        }
+        catch (armnn::Exception& e)
+        {
+            ALOGW("armnn::Exception caught from EnqueueWorkload: %s", e.what());
+            status = ErrorStatus::GENERAL_FAILURE;
+        }
+        const RequestTimings::Clock::time_point workloadFinished = RequestTimings::Clock::now();
+
+        if (status == ErrorStatus::NONE)
+        {
+            DumpTensorsIfRequired("Output", slots[0]->m_RequestIndex, m_BatchOutputTensors);
+
+            // Scatter the outputs back to the memory of each request
+            for (unsigned int i = 0; i < m_OutputBindings.size(); i++)
+            {
+                const unsigned int numBytes = m_OutputBindings[i].m_NumBytes;
+                for (unsigned int s = 0; s < numSlots; s++)
+                {
+                    std::memcpy(slots[s]->m_OutputTensors[i].second.GetMemoryArea(),
+                                m_BatchOutputStorage[i].data() + s * numBytes,
+                                numBytes);
+                }
+            }
+
+            for (unsigned int s = 0; s < numSlots; s++)
+            {
+                CommitOutputs(slots[s]);
+                slots[s]->m_Timings.Set(RequestStage::WorkloadStarted, workloadStarted);
+                slots[s]->m_Timings.Set(RequestStage::WorkloadFinished, workloadFinished);
+                slots[s]->m_Timings.Record(RequestStage::Committed);
+            }
+        }
+    }
+
+    for (unsigned int s = 0; s < numSlots; s++)
+    {
+        const ::android::sp<IExecutionCallback> callback = slots[s]->m_Callback;
+        RequestTimings timings = slots[s]->m_Timings;
+        m_RequestSlots.Release(slots[s]);
+        CompleteRequest();
+        NotifyCallbackAndCheck(callback, status, "ArmnnPreparedModel::ExecuteGraphBatch");
+
+        if (status == ErrorStatus::NONE)
+        {
+            timings.Record(RequestStage::Notified);
+            m_LatencyStats.Add(timings);
+        }
+    }
+
+    FinishPostedRequests(numSlots);
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::LinkToClientDeath(const ::android::sp<IExecutionCallback>& callback)
+{
+    std::lock_guard<std::mutex> lock(m_ClientLinkMutex);
+    if (m_ClientLink != nullptr)
+    {
+        return;
+    }
+
+    // All the callbacks of a prepared model come from the client that prepared it, so linking to the first one
+    // is enough to be notified when that process dies. Linking fails for callbacks living in the driver process,
+    // which is not an error. The recipient is created here, as the client holds a strong reference to the model.
+    m_ClientDeathRecipient = new ClientDeathRecipient(this);
+    Return<bool> linked = callback->linkToDeath(m_ClientDeathRecipient, 0);
+    if (!linked.isOk() || !linked)
+    {
+        ALOGV("ArmnnPreparedModel::LinkToClientDeath: could not link to the death of the client");
+    }
+    m_ClientLink = callback;
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::HandleClientDeath()
+{
+    ALOGD("ArmnnPreparedModel: client died, dropping its queued requests and releasing its memory pools");
+    // The requests are dropped by the request thread as it reaches them, as they cannot be removed from its queue
+    m_ClientDied.store(true);
+    m_MemoryPoolCache.Clear();
+}
+
+template<typename HalVersion>
+void ArmnnPreparedModel<HalVersion>::ClientDeathRecipient::serviceDied(
+        uint64_t /*cookie*/, const ::android::wp<::android::hidl::base::V1_0::IBase>& /*who*/)
+{
+    ::android::sp<ArmnnPreparedModel> preparedModel = m_PreparedModel.promote();
+    if (preparedModel != nullptr)
+    {
+        preparedModel->HandleClientDeath();
+    }
 }
 
 template<typename HalVersion>
 void ArmnnPreparedModel<HalVersion>::ExecuteWithDummyInputs()
 {
+    // A deferred warm-up runs once the client has the model, so it is serialized with its requests
+    std::lock_guard<std::mutex> executionLock(m_ExecutionMutex);
+    if (m_RequestCount.load() != 0)
+    {
+        // The first request compiles the kernels anyway, warming up now would only delay it
+        ALOGV("ExecuteWithDummyInputs: requests were already submitted, skipping the warm-up");
+        return;
+    }
+
+    if (!m_Network->Load())
+    {
+        return;
+    }
+
     std::vector<std::vector<char>> storage;
     armnn::InputTensors inputTensors;
-    for (unsigned int i = 0; i < m_Model.inputIndexes.size(); i++)
+    for (unsigned int i = 0; i < m_InputBindings.size(); i++)
     {
-        const armnn::TensorInfo inputTensorInfo = m_Runtime->GetInputTensorInfo(m_NetworkId, i);
-        storage.emplace_back(inputTensorInfo.GetNumBytes());
-        const armnn::ConstTensor inputTensor(inputTensorInfo, storage.back().data());
+        const TensorBinding& binding = m_InputBindings[i];
+        storage.emplace_back(binding.m_NumBytes);
+        const armnn::ConstTensor inputTensor(binding.m_TensorInfo, storage.back().data());
 
         inputTensors.emplace_back(i, inputTensor);
     }
 
     armnn::OutputTensors outputTensors;
-    for (unsigned int i = 0; i < m_Model.outputIndexes.size(); i++)
+    for (unsigned int i = 0; i < m_OutputBindings.size(); i++)
     {
-        const armnn::TensorInfo outputTensorInfo = m_Runtime->GetOutputTensorInfo(m_NetworkId, i);
-        storage.emplace_back(outputTensorInfo.GetNumBytes());
-        const armnn::Tensor outputTensor(outputTensorInfo, storage.back().data());
+        const TensorBinding& binding = m_OutputBindings[i];
+        storage.emplace_back(binding.m_NumBytes);
+        const armnn::Tensor outputTensor(binding.m_TensorInfo, storage.back().data());
 
         outputTensors.emplace_back(i, outputTensor);
     }
 
     try
     {
-        m_Runtime->EnqueueWorkload(m_NetworkId, inputTensors, outputTensors);
+        m_Runtime->EnqueueWorkload(m_Network->GetNetworkId(), inputTensors, outputTensors);
+        if (m_BatchedNetwork.IsValid() && m_Network->GetBatchedNetwork().IsValid())
+        {
+            // The batched network uses its own kernels, which must be prepared as well
+            m_Runtime->EnqueueWorkload(m_Network->GetBatchedNetwork().m_NetworkId,
+                                       m_BatchInputTensors,
+                                       m_BatchOutputTensors);
+        }
     }
     catch (armnn::Exception& e)
     {
@@ -7,11 +7,22 @@
 
 #include "ArmnnDriver.hpp"
 #include "ArmnnDriverImpl.hpp"
+#include "MemoryPoolCache.hpp"
+#include "PreparedNetworkCache.hpp"
+#include "RequestBatching.hpp"
+#include "RequestSlotPool.hpp"
 #include "RequestThread.hpp"
+#include "RequestTimings.hpp"
+#include "Utils.hpp"
 
 #include <NeuralNetworks.h>
 #include <armnn/ArmNN.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -24,37 +35,206 @@ class ArmnnPreparedModel : public IPreparedModel
 public:
     using HalModel = typename HalVersion::Model;
 
-    ArmnnPreparedModel(armnn::NetworkId networkId,
-                       armnn::IRuntime* runtime,
+    /// @param[in] network the network the model was converted to, which may be shared with identical models.
+    ///                    It must be loaded, and its execution mutex held by the caller.
+    ArmnnPreparedModel(const std::shared_ptr<SharedNetwork>& network,
                        const HalModel& model,
+                       const std::shared_ptr<RequestThread<HalVersion>>& requestThread,
                        const std::string& requestInputsAndOutputsDumpDir,
-                       const bool gpuProfilingEnabled);
+                       const bool gpuProfilingEnabled,
+                       const PerformancePreference preference = PerformancePreference::FastSingleAnswer,
+                       const unsigned int latencyLogPeriod = 0,
+                       const unsigned int maxPendingRequests = 0,
+                       const std::chrono::milliseconds pendingRequestsTimeout = std::chrono::milliseconds(0));
 
     virtual ~ArmnnPreparedModel();
 
     virtual Return<ErrorStatus> execute(const Request& request,
                                         const ::android::sp<IExecutionCallback>& callback) override;
 
-    /// execute the graph prepared from the request
-    void ExecuteGraph(std::shared_ptr<std::vector<::android::nn::RunTimePoolInfo>>& pMemPools,
-                      std::shared_ptr<armnn::InputTensors>& pInputTensors,
-                      std::shared_ptr<armnn::OutputTensors>& pOutputTensors,
-                      const ::android::sp<IExecutionCallback>& callback);
+    /// execute the graph prepared from the request, and return the slot of the request to the pool
+    void ExecuteGraph(RequestSlot* slot);
 
-    /// Executes this model with dummy inputs (e.g. all zeroes).
+    /// Executes several requests at once with the batched network, and returns their slots to the pool
+    /// @param[in] slots the requests to execute, in the order they were posted
+    /// @param[in] numSlots the number of requests, at most GetMaxBatchSize()
+    void ExecuteGraphBatch(RequestSlot* const* slots, unsigned int numSlots);
+
+    /// Returns the maximum number of requests that can be executed together by ExecuteGraphBatch,
+    /// 1 if the model is not executed in batches
+    unsigned int GetMaxBatchSize() const { return m_BatchedNetwork.m_BatchSize; }
+
+    /// Returns how long to wait for more requests to fill a batch
+    std::chrono::microseconds GetMaxBatchWait() const { return m_BatchedNetwork.m_MaxWait; }
+
+    /// Returns the preference the model was prepared with, which decides the priority of its requests
+    PerformancePreference GetPerformancePreference() const { return m_Preference; }
+
+    /// Executes this model with dummy inputs (e.g. all zeroes), unless requests were already submitted.
+    /// Safe to call while the client submits requests.
     void ExecuteWithDummyInputs();
 
+    /// Returns the id of the network executing the model in the runtime when it was prepared, for testing
+    armnn::NetworkId GetNetworkId() const { return m_NetworkId; }
+
+    /// Returns the id telling apart the prepared models sharing a network in the names of the dumped files
+    unsigned int GetPreparedModelId() const { return m_PreparedModelId; }
+
+    /// Returns the network executing the model, for testing
+    const SharedNetwork& GetNetwork() const { return *m_Network; }
+
+    /// Returns the number of times the request slots were created or grown, for testing
+    std::size_t GetNumRequestSlotGrowths() const { return m_RequestSlots.GetNumGrowths(); }
+
+    /// Returns the cache of the memory pools mapped for the requests, for testing
+    const MemoryPoolCache& GetMemoryPoolCache() const { return m_MemoryPoolCache; }
+
+    /// Called when the client process dies: its requests still queued are dropped without being executed or
+    /// notified, and the memory pools it shared are released
+    void HandleClientDeath();
+
+    /// Returns the number of queued requests dropped because the client died, for testing
+    std::size_t GetNumDroppedRequests() const { return m_NumDroppedRequests.load(); }
+
+    /// Returns the limit on the requests pending for this model, which also counts them
+    const PendingRequestLimit& GetPendingRequestLimit() const { return m_PendingRequestLimit; }
+
+    /// Returns the latencies of the steps of the requests executed so far
+    const RequestLatencyStats& GetLatencyStats() const { return m_LatencyStats; }
+
+    /// Writes the latencies of the requests to the requests inputs and outputs dump directory, if set.
+    /// Also done when the model is destroyed.
+    void DumpLatencyStats() const;
+
 private:
+    /// The tensor info of an input or output of the network, with its size in bytes
+    struct TensorBinding
+    {
+        TensorBinding(const armnn::TensorInfo& tensorInfo)
+            : m_TensorInfo(tensorInfo)
+            , m_NumBytes(tensorInfo.GetNumBytes())
+        {
+        }
+
+        armnn::TensorInfo m_TensorInfo;
+        unsigned int      m_NumBytes;
+    };
+
+    /// What the prepared model keeps of its model: the input and output operands to validate the requests, and the
+    /// summary logged with them. The constant values and memory pools of the model are released once it is prepared.
+    struct ModelMetadata
+    {
+        ModelMetadata(const HalModel& model)
+            : m_InputsAndOutputs(GetInputsAndOutputsModel(model))
+            , m_Summary(GetModelSummary(model))
+        {
+        }
+
+        const HalModel    m_InputsAndOutputs;
+        const std::string m_Summary;
+    };
+
+    /// Drops the queued requests and the cached memory pools when the client process dies
+    class ClientDeathRecipient : public ::android::hardware::hidl_death_recipient
+    {
+    public:
+        ClientDeathRecipient(const ::android::wp<ArmnnPreparedModel>& preparedModel)
+            : m_PreparedModel(preparedModel)
+        {
+        }
+
+        void serviceDied(uint64_t cookie, const ::android::wp<::android::hidl::base::V1_0::IBase>& who) override;
+
+    private:
+        // The client may die while the model is being destroyed
+        ::android::wp<ArmnnPreparedModel> m_PreparedModel;
+    };
+
+    /// Admits a client request if the limits on the pending requests for this model and for the driver allow it,
+    /// waiting for pending requests to complete for up to the configured timeout
+    /// @return false if the request must be rejected
+    bool AdmitRequest();
+
+    /// Completes a client request admitted by AdmitRequest
+    void CompleteRequest();
+
+    /// Maps the memory pools of a request and binds its arguments to the inputs and outputs of the network
+    ErrorStatus BindRequest(const Request& request, RequestSlot* slot);
+
+    /// Posts a bound request to the request thread
+    void PostRequest(RequestSlot* slot);
+
+    /// Records that the request thread is done with posted requests, letting the destructor proceed once none is left.
+    /// Must be the last access of the request thread to the model.
+    void FinishPostedRequests(unsigned int numRequests);
+
+    /// Runs a bound request and commits its outputs, loading the network again if it was unloaded.
+    /// Must be called with the execution mutex held.
+    ErrorStatus RunRequest(RequestSlot* slot);
+
+    /// Commits the memory pools written by the outputs of a request
+    void CommitOutputs(RequestSlot* slot);
+
+    /// Returns a request of a dead client to the pool without executing it
+    /// @return true if the request was dropped, false if it must be executed
+    bool DropRequestIfClientDied(RequestSlot* slot);
+
+    /// Allocates the buffers used to stack the inputs and outputs of batched requests
+    bool InitializeBatching();
+
+    /// Registers for the death of the client the first time it submits a request
+    void LinkToClientDeath(const ::android::sp<IExecutionCallback>& callback);
+
     template <typename TensorBindingCollection>
-    void DumpTensorsIfRequired(char const* tensorNamePrefix, const TensorBindingCollection& tensorBindings);
+    void DumpTensorsIfRequired(char const* tensorNamePrefix,
+                               uint32_t requestIndex,
+                               const TensorBindingCollection& tensorBindings);
 
+    // Keeps the network as long as the model exists. It may be unloaded to fit the budget of the loaded networks,
+    // in which case it is loaded again with other ids, so only m_NetworkId, which names the dumped files, is kept.
+    std::shared_ptr<SharedNetwork>   m_Network;
     armnn::NetworkId                 m_NetworkId;
+    // Unique to this model, the dumped files are named after it too as several models may share the network
+    const unsigned int               m_PreparedModelId;
     armnn::IRuntime*                 m_Runtime;
-    HalModel                         m_Model;
-    // There must be a single RequestThread for all ArmnnPreparedModel objects to ensure serial execution of workloads
-    // It is specific to this class, so it is declared as static here
-    static RequestThread<HalVersion> m_RequestThread;
-    uint32_t                         m_RequestCount;
+    const ModelMetadata              m_Metadata;
+    std::vector<TensorBinding>       m_InputBindings;
+    std::vector<TensorBinding>       m_OutputBindings;
+    const PerformancePreference      m_Preference;
+    // The RequestThread is shared by all the ArmnnPreparedModel objects created by a driver. All the requests
+    // for this model are posted to the same worker, to ensure serial execution of its workloads
+    std::shared_ptr<RequestThread<HalVersion>> m_RequestThread;
+    const unsigned int               m_RequestThreadWorker;
+    // The per-request state is recycled, so that the steady-state submission path does not allocate it
+    RequestSlotPool                  m_RequestSlots;
+    // Serializes the execution of the network between the request thread, the deferred warm-up and the other
+    // prepared models sharing the network
+    std::mutex&                      m_ExecutionMutex;
+    // The requests posted to the request thread that it is not done with. The request thread refers to the model and
+    // to the slots of these requests, including those of a dead client it drops, so the destructor waits for them.
+    std::mutex                       m_PostedRequestsMutex;
+    std::condition_variable          m_PostedRequestsDone;
+    unsigned int                     m_NumPostedRequests;
+    // The client requests admitted and not completed yet, and how long execute waits when there are too many
+    PendingRequestLimit              m_PendingRequestLimit;
+    const std::chrono::milliseconds  m_PendingRequestsTimeout;
+    // Clients usually reuse the same memory for every request, so the mapped pools are kept between requests
+    MemoryPoolCache                  m_MemoryPoolCache;
+    ::android::sp<ClientDeathRecipient> m_ClientDeathRecipient;
+    std::atomic<bool>                   m_ClientDied;
+    std::atomic<std::size_t>            m_NumDroppedRequests;
+    RequestLatencyStats                 m_LatencyStats;
+    // The callback the death recipient is linked to, kept to unlink the recipient on destruction
+    std::mutex                          m_ClientLinkMutex;
+    ::android::sp<IExecutionCallback>   m_ClientLink;
+    // The network executing batches of requests, and the buffers its inputs and outputs are stacked into
+    BatchedNetwork                   m_BatchedNetwork;
+    std::vector<std::vector<uint8_t>> m_BatchInputStorage;
+    std::vector<std::vector<uint8_t>> m_BatchOutputStorage;
+    armnn::InputTensors              m_BatchInputTensors;
+    armnn::OutputTensors             m_BatchOutputTensors;
+    // Incremented by execute, which the clients call concurrently from several binder threads
+    std::atomic<uint32_t>            m_RequestCount;
     const std::string&               m_RequestInputsAndOutputsDumpDir;
     const bool                       m_GpuProfilingEnabled;
 };
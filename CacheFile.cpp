@@ -0,0 +1,274 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "CacheFile.hpp"
+#include "ModelHash.hpp"
+
+#include <log/log.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace armnn_driver
+{
+
+namespace
+{
+
+const char g_Magic[8] = { 'A', 'R', 'M', 'N', 'N', 'D', 'R', 'V' };
+
+// To be incremented whenever the layout of the files changes
+const uint32_t g_FormatVersion = 1;
+
+// The blobs and their names are aligned in the file, so that the data of the blobs can be used in place
+const std::size_t g_Alignment = 8;
+
+struct Header
+{
+    char      m_Magic[8];
+    uint32_t  m_FormatVersion;
+    uint32_t  m_NumBlobs;
+    uint64_t  m_PayloadSize;
+    ModelHash m_KeyHash;
+    ModelHash m_PayloadHash;
+};
+
+struct BlobHeader
+{
+    uint32_t m_NameLength;
+    uint32_t m_Reserved;
+    uint64_t m_NumBytes;
+};
+
+static_assert(sizeof(Header) % g_Alignment == 0, "The payload must be aligned");
+static_assert(sizeof(BlobHeader) % g_Alignment == 0, "The blob names must be aligned");
+
+std::size_t Align(std::size_t size)
+{
+    return (size + g_Alignment - 1) / g_Alignment * g_Alignment;
+}
+
+ModelHash HashKey(const std::string& key)
+{
+    ModelHasher hasher;
+    hasher.Add(key.data(), key.size());
+    return hasher.GetHash();
+}
+
+ModelHash HashPayload(const uint8_t* payload, std::size_t payloadSize)
+{
+    ModelHasher hasher;
+    hasher.Add(payload, payloadSize);
+    return hasher.GetHash();
+}
+
+void DiscardFile(const std::string& path, const char* reason)
+{
+    ALOGW("CacheFile: Discarding cache file %s: %s", path.c_str(), reason);
+    if (unlink(path.c_str()) != 0 && errno != ENOENT)
+    {
+        ALOGW("CacheFile: Failed to delete %s: %s", path.c_str(), strerror(errno));
+    }
+}
+
+bool WriteAll(int fd, const void* data, std::size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0)
+    {
+        const ssize_t written = write(fd, bytes, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+CacheFile::CacheFile(void* mapping, std::size_t size)
+    : m_Mapping(mapping)
+    , m_Size(size)
+{
+}
+
+CacheFile::~CacheFile()
+{
+    munmap(m_Mapping, m_Size);
+}
+
+std::unique_ptr<CacheFile> CacheFile::Open(const std::string& path, const std::string& key)
+{
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        if (errno != ENOENT)
+        {
+            ALOGW("CacheFile: Failed to open %s: %s", path.c_str(), strerror(errno));
+        }
+        return nullptr;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+        ALOGW("CacheFile: Failed to stat %s: %s", path.c_str(), strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(fileStat.st_size);
+    if (size < sizeof(Header))
+    {
+        close(fd);
+        DiscardFile(path, "truncated header");
+        return nullptr;
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid once the file is closed
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        ALOGW("CacheFile: Failed to map %s: %s", path.c_str(), strerror(errno));
+        return nullptr;
+    }
+
+    std::unique_ptr<CacheFile> file(new CacheFile(mapping, size));
+
+    Header header;
+    memcpy(&header, mapping, sizeof(header));
+    const uint8_t* payload = static_cast<const uint8_t*>(mapping) + sizeof(header);
+
+    if (memcmp(header.m_Magic, g_Magic, sizeof(g_Magic)) != 0)
+    {
+        DiscardFile(path, "not a cache file");
+        return nullptr;
+    }
+    if (header.m_FormatVersion != g_FormatVersion || header.m_KeyHash != HashKey(key))
+    {
+        DiscardFile(path, "stale");
+        return nullptr;
+    }
+    if (header.m_PayloadSize != size - sizeof(header) ||
+        header.m_PayloadHash != HashPayload(payload, size - sizeof(header)))
+    {
+        DiscardFile(path, "corrupt");
+        return nullptr;
+    }
+    if (!file->ParseBlobs(payload, size - sizeof(header), header.m_NumBlobs))
+    {
+        DiscardFile(path, "invalid blobs");
+        return nullptr;
+    }
+
+    return file;
+}
+
+bool CacheFile::ParseBlobs(const uint8_t* payload, std::size_t payloadSize, uint32_t numBlobs)
+{
+    m_Blobs.reserve(numBlobs);
+
+    std::size_t offset = 0;
+    for (uint32_t i = 0; i < numBlobs; ++i)
+    {
+        if (payloadSize - offset < sizeof(BlobHeader))
+        {
+            return false;
+        }
+        BlobHeader blobHeader;
+        memcpy(&blobHeader, payload + offset, sizeof(blobHeader));
+        offset += sizeof(blobHeader);
+
+        const std::size_t nameSize = Align(blobHeader.m_NameLength);
+        if (payloadSize - offset < nameSize)
+        {
+            return false;
+        }
+        const char* name = reinterpret_cast<const char*>(payload + offset);
+        offset += nameSize;
+
+        if (payloadSize - offset < blobHeader.m_NumBytes)
+        {
+            return false;
+        }
+        const std::size_t numBytes = static_cast<std::size_t>(blobHeader.m_NumBytes);
+        m_Blobs.push_back({ std::string(name, blobHeader.m_NameLength), payload + offset, numBytes });
+        offset += std::min(Align(numBytes), payloadSize - offset);
+    }
+
+    return offset == payloadSize;
+}
+
+bool CacheFile::Write(const std::string& path, const std::string& key, const std::vector<Blob>& blobs)
+{
+    // The blobs are laid out in memory first, as the header holds the checksum of the payload
+    std::size_t payloadSize = 0;
+    for (const Blob& blob : blobs)
+    {
+        payloadSize += sizeof(BlobHeader) + Align(blob.m_Name.size()) + Align(blob.m_NumBytes);
+    }
+
+    std::vector<uint8_t> payload(payloadSize, 0);
+    std::size_t offset = 0;
+    for (const Blob& blob : blobs)
+    {
+        const BlobHeader blobHeader = { static_cast<uint32_t>(blob.m_Name.size()), 0, blob.m_NumBytes };
+        memcpy(payload.data() + offset, &blobHeader, sizeof(blobHeader));
+        offset += sizeof(blobHeader);
+        memcpy(payload.data() + offset, blob.m_Name.data(), blob.m_Name.size());
+        offset += Align(blob.m_Name.size());
+        memcpy(payload.data() + offset, blob.m_Data, blob.m_NumBytes);
+        offset += Align(blob.m_NumBytes);
+    }
+
+    Header header;
+    memcpy(header.m_Magic, g_Magic, sizeof(g_Magic));
+    header.m_FormatVersion = g_FormatVersion;
+    header.m_NumBlobs      = static_cast<uint32_t>(blobs.size());
+    header.m_PayloadSize   = payloadSize;
+    header.m_KeyHash       = HashKey(key);
+    header.m_PayloadHash   = HashPayload(payload.data(), payloadSize);
+
+    // Written to a temporary file renamed over the previous one, so that a crash never leaves a partial file
+    const std::string tempPath = path + ".tmp";
+    const int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        ALOGW("CacheFile: Failed to create %s: %s", tempPath.c_str(), strerror(errno));
+        return false;
+    }
+
+    const bool written = WriteAll(fd, &header, sizeof(header)) &&
+                         WriteAll(fd, payload.data(), payload.size()) &&
+                         fsync(fd) == 0;
+    const int writeError = errno;
+    close(fd);
+
+    if (!written || rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        ALOGW("CacheFile: Failed to write %s: %s", path.c_str(), strerror(written ? errno : writeError));
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace armnn_driver
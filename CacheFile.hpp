@@ -0,0 +1,58 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// A file of the on-disk cache of the driver, holding named binary blobs. The file starts with a header recording
+/// its format, the key it was written for (e.g. the driver build and the device) and a checksum of the blobs, so
+/// that stale and corrupt files are detected when they are opened. Files are memory-mapped when read.
+class CacheFile
+{
+public:
+    struct Blob
+    {
+        std::string    m_Name;
+        const uint8_t* m_Data;
+        std::size_t    m_NumBytes;
+    };
+
+    ~CacheFile();
+
+    CacheFile(const CacheFile&) = delete;
+    CacheFile& operator=(const CacheFile&) = delete;
+
+    /// Maps a cache file and validates it
+    /// @return nullptr if the file does not exist, or if it is corrupt or was written for another key, in which
+    ///         case it is also deleted
+    static std::unique_ptr<CacheFile> Open(const std::string& path, const std::string& key);
+
+    /// Writes a cache file, atomically replacing any existing one
+    /// @return false if the file could not be written
+    static bool Write(const std::string& path, const std::string& key, const std::vector<Blob>& blobs);
+
+    /// Returns the blobs of the file. Their data points into the mapped file, and is valid as long as it is open.
+    const std::vector<Blob>& GetBlobs() const { return m_Blobs; }
+
+private:
+    CacheFile(void* mapping, std::size_t size);
+
+    /// Reads the blobs from the mapped file, checking that they fit in it
+    bool ParseBlobs(const uint8_t* payload, std::size_t payloadSize, uint32_t numBlobs);
+
+    void*             m_Mapping;
+    std::size_t       m_Size;
+    std::vector<Blob> m_Blobs;
+};
+
+} // namespace armnn_driver
@@ -0,0 +1,177 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "ClProgramCache.hpp"
+#include "CacheFile.hpp"
+#include "Utils.hpp"
+
+#include <arm_compute/core/CL/CLKernelLibrary.h>
+#include <arm_compute/runtime/CL/CLScheduler.h>
+
+#include <log/log.h>
+
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace armnn_driver
+{
+
+ClProgramCache::ClProgramCache(const std::string& cacheDir)
+    : m_FilePath(cacheDir.empty() ? "" : cacheDir + "/cl_programs.armnn-cache")
+    , m_NumSavedPrograms(0)
+{
+}
+
+std::string ClProgramCache::GetKey() const
+{
+    std::stringstream key;
+
+    // The programs are compiled from the kernels of the Compute Library linked in the driver, so they are stale
+    // once the driver is updated
+    struct stat driverStat;
+    if (stat("/proc/self/exe", &driverStat) == 0)
+    {
+        key << driverStat.st_size << ";" << driverStat.st_mtime << ";";
+    }
+
+    // The binaries are specific to the device and to the version of its OpenCL driver
+    const cl::Device device = arm_compute::CLScheduler::get().context().getInfo<CL_CONTEXT_DEVICES>().at(0);
+    key << device.getInfo<CL_DEVICE_NAME>() << ";"
+        << device.getInfo<CL_DEVICE_VERSION>() << ";"
+        << device.getInfo<CL_DRIVER_VERSION>();
+
+    return key.str();
+}
+
+unsigned int ClProgramCache::Restore()
+{
+    if (!IsEnabled())
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> saveLock(m_SaveMutex);
+
+    // The file is read and the programs are built from their binaries without holding the network loading mutex,
+    // which is only needed to add them to the kernel library
+    std::vector<std::pair<std::string, cl::Program>> programs;
+    try
+    {
+        std::unique_ptr<CacheFile> file = CacheFile::Open(m_FilePath, GetKey());
+        if (file)
+        {
+            const cl::Context& context = arm_compute::CLScheduler::get().context();
+            const std::vector<cl::Device> devices = context.getInfo<CL_CONTEXT_DEVICES>();
+
+            programs.reserve(file->GetBlobs().size());
+            for (const CacheFile::Blob& blob : file->GetBlobs())
+            {
+                try
+                {
+                    const cl::Program::Binaries binaries{
+                        std::vector<unsigned char>(blob.m_Data, blob.m_Data + blob.m_NumBytes) };
+                    cl::Program program(context, devices, binaries);
+                    program.build();
+                    programs.emplace_back(blob.m_Name, program);
+                }
+                catch (const cl::Error& error)
+                {
+                    // The program will be compiled again from its source when needed
+                    ALOGW("ClProgramCache: Failed to restore program %s: %s (%d)",
+                          blob.m_Name.c_str(), error.what(), error.err());
+                }
+            }
+        }
+    }
+    catch (const cl::Error& error)
+    {
+        ALOGW("ClProgramCache: Failed to restore the programs from %s: %s (%d)",
+              m_FilePath.c_str(), error.what(), error.err());
+    }
+
+    unsigned int numRestored = 0;
+    {
+        // Programs are compiled while networks are loaded, so the kernel library is not modified concurrently
+        std::lock_guard<std::mutex> lock(GetNetworkLoadingMutex());
+
+        arm_compute::CLKernelLibrary& kernelLibrary = arm_compute::CLKernelLibrary::get();
+        for (const auto& program : programs)
+        {
+            if (kernelLibrary.get_built_programs().count(program.first) == 0)
+            {
+                kernelLibrary.add_built_program(program.first, program.second);
+                ++numRestored;
+            }
+        }
+        m_NumSavedPrograms = kernelLibrary.get_built_programs().size();
+    }
+
+    ALOGI("ClProgramCache: Restored %u OpenCL programs from %s", numRestored, m_FilePath.c_str());
+    return numRestored;
+}
+
+void ClProgramCache::Save()
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> saveLock(m_SaveMutex);
+
+    // Only the handles of the programs are copied under the network loading mutex: their binaries are queried and
+    // written to disk once it is released, so that loading and unloading networks does not wait for the disk
+    std::vector<std::pair<std::string, cl::Program>> programs;
+    {
+        std::lock_guard<std::mutex> lock(GetNetworkLoadingMutex());
+
+        const auto& builtPrograms = arm_compute::CLKernelLibrary::get().get_built_programs();
+        if (builtPrograms.size() == m_NumSavedPrograms)
+        {
+            return;
+        }
+        programs.assign(builtPrograms.begin(), builtPrograms.end());
+    }
+
+    try
+    {
+        std::vector<cl::Program::Binaries> binaries;
+        binaries.reserve(programs.size());
+        std::vector<CacheFile::Blob> blobs;
+        blobs.reserve(programs.size());
+
+        for (const auto& program : programs)
+        {
+            binaries.push_back(program.second.getInfo<CL_PROGRAM_BINARIES>());
+            // The context has a single device, so each program has a single binary
+            if (binaries.back().size() != 1 || binaries.back()[0].empty())
+            {
+                continue;
+            }
+            blobs.push_back({ program.first, binaries.back()[0].data(), binaries.back()[0].size() });
+        }
+
+        if (CacheFile::Write(m_FilePath, GetKey(), blobs))
+        {
+            ALOGV("ClProgramCache: Saved %zu OpenCL programs to %s", blobs.size(), m_FilePath.c_str());
+        }
+    }
+    catch (const cl::Error& error)
+    {
+        ALOGW("ClProgramCache: Failed to save the programs to %s: %s (%d)",
+              m_FilePath.c_str(), error.what(), error.err());
+    }
+
+    // Not retried on failure until new programs are compiled
+    m_NumSavedPrograms = programs.size();
+}
+
+} // namespace armnn_driver
@@ -0,0 +1,43 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+namespace armnn_driver
+{
+
+/// Saves the OpenCL programs compiled by the Compute Library to the on-disk cache, and restores them when the driver
+/// restarts, so that loading networks on GpuAcc does not compile the same kernels again after every restart.
+/// The cache is discarded when the driver binary or the OpenCL device or driver change.
+class ClProgramCache
+{
+public:
+    /// @param[in] cacheDir the directory of the on-disk cache, or an empty string to disable the cache
+    ClProgramCache(const std::string& cacheDir);
+
+    bool IsEnabled() const { return !m_FilePath.empty(); }
+
+    /// Restores the programs saved by a previous run. Must be called once the runtime has initialised OpenCL.
+    /// @return the number of programs restored
+    unsigned int Restore();
+
+    /// Saves all the programs compiled so far, if some were compiled since the last call to Restore or Save
+    void Save();
+
+private:
+    /// Returns the key the cache file is written for, identifying the driver binary and the OpenCL device
+    std::string GetKey() const;
+
+    std::string m_FilePath;
+    // Serialises the reads and writes of the cache file, which are done without holding the network loading mutex
+    std::mutex  m_SaveMutex;
+    std::size_t m_NumSavedPrograms;
+};
+
+} // namespace armnn_driver
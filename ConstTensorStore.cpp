@@ -0,0 +1,128 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "ConstTensorStore.hpp"
+#include "Utils.hpp"
+
+#include <log/log.h>
+
+#include <algorithm>
+
+namespace
+{
+
+using namespace armnn_driver;
+
+// The number of entries below which the released values are not pruned
+const std::size_t g_MinPruneThreshold = 64;
+
+ModelHash HashTensor(const armnn::TensorInfo& tensorInfo, const void* values, const armnn::PermutationVector& mappings)
+{
+    ModelHasher hasher;
+    hasher.AddValue(tensorInfo.GetDataType());
+    hasher.AddValue(tensorInfo.GetNumDimensions());
+    for (unsigned int i = 0; i < tensorInfo.GetNumDimensions(); ++i)
+    {
+        hasher.AddValue(tensorInfo.GetShape()[i]);
+    }
+    hasher.AddValue(tensorInfo.GetQuantizationScale());
+    hasher.AddValue(tensorInfo.GetQuantizationOffset());
+
+    hasher.AddValue(mappings.GetSize());
+    for (unsigned int i = 0; i < mappings.GetSize(); ++i)
+    {
+        hasher.AddValue(mappings[i]);
+    }
+
+    hasher.Add(values, tensorInfo.GetNumBytes());
+    return hasher.GetHash();
+}
+
+} // anonymous namespace
+
+namespace armnn_driver
+{
+
+ConstTensorStore::ConstTensorStore()
+    : m_PruneThreshold(g_MinPruneThreshold)
+    , m_NumReusedPermutedBytes(0)
+{
+}
+
+ConstTensorStore::Values ConstTensorStore::GetPermuted(const armnn::TensorInfo& tensorInfo,
+                                                       const void* values,
+                                                       const armnn::PermutationVector& mappings)
+{
+    const ModelHash hash = HashTensor(tensorInfo, values, mappings);
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Values.find(hash);
+        Values storedValues = it != m_Values.end() ? it->second.lock() : nullptr;
+        if (storedValues)
+        {
+            m_NumReusedPermutedBytes += storedValues->size();
+            ALOGV("ConstTensorStore: sharing %zu bytes of constant tensor %s",
+                  storedValues->size(), ModelHashToString(hash).c_str());
+            return storedValues;
+        }
+    }
+
+    // Permuted without holding the lock, as the tensors can be large. Should another conversion permute the same
+    // tensor meanwhile, both are kept but only the last one is shared from then on.
+    auto permutedValues = std::make_shared<std::vector<uint8_t>>(tensorInfo.GetNumBytes());
+    SwizzleAndroidNn4dTensorToArmNn(tensorInfo, values, permutedValues->data(), mappings);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Replaces the entry of released values with the same hash, if any
+    m_Values[hash] = permutedValues;
+
+    // The store does not grow with every tensor ever converted, yet walking it on every insertion would make
+    // converting many tensors quadratic, so the released values are only pruned once the entries have doubled
+    if (m_Values.size() >= m_PruneThreshold)
+    {
+        PruneReleasedValues();
+    }
+    return permutedValues;
+}
+
+void ConstTensorStore::PruneReleasedValues()
+{
+    for (auto it = m_Values.begin(); it != m_Values.end();)
+    {
+        it = it->second.expired() ? m_Values.erase(it) : std::next(it);
+    }
+    m_PruneThreshold = std::max(g_MinPruneThreshold, 2 * m_Values.size());
+}
+
+std::size_t ConstTensorStore::GetNumStoredBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    std::size_t numBytes = 0;
+    for (const auto& entry : m_Values)
+    {
+        Values values = entry.second.lock();
+        numBytes += values ? values->size() : 0;
+    }
+    return numBytes;
+}
+
+std::size_t ConstTensorStore::GetNumEntries() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Values.size();
+}
+
+ConstTensorStore& GetConstTensorStore()
+{
+    static ConstTensorStore constTensorStore;
+    return constTensorStore;
+}
+
+} // namespace armnn_driver
@@ -0,0 +1,66 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "ModelHash.hpp"
+
+#include <armnn/ArmNN.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// The values of the constant tensors permuted by the conversions of models, identified by the hash of their values,
+/// TensorInfo and permutation, so that identical tensors converted at the same time, e.g. the weights shared by
+/// several models or variants of a model prepared concurrently, are permuted and stored once. The values are released
+/// when the last ConstTensorPin using them is destroyed. All the methods can be called from any thread.
+class ConstTensorStore
+{
+public:
+    using Values = std::shared_ptr<const std::vector<uint8_t>>;
+
+    ConstTensorStore();
+
+    /// Returns the values of a tensor permuted according to the mappings, permuting them unless they are stored already
+    Values GetPermuted(const armnn::TensorInfo& tensorInfo,
+                       const void* values,
+                       const armnn::PermutationVector& mappings);
+
+    /// Returns the number of bytes of the values stored
+    std::size_t GetNumStoredBytes() const;
+
+    /// Returns the total number of bytes that were not permuted again, as identical permuted values were still stored.
+    /// This counts the permutations avoided, not the memory saved, as the values are only shared while in use.
+    std::size_t GetNumReusedPermutedBytes() const { return m_NumReusedPermutedBytes.load(); }
+
+    /// Returns the number of entries of the store, including those of released values not pruned yet, for testing
+    std::size_t GetNumEntries() const;
+
+private:
+    ConstTensorStore(const ConstTensorStore&) = delete;
+    ConstTensorStore& operator=(const ConstTensorStore&) = delete;
+
+    /// Forgets the values released since the last call. Must be called with the mutex held.
+    void PruneReleasedValues();
+
+    mutable std::mutex                                             m_Mutex;
+    std::map<ModelHash, std::weak_ptr<const std::vector<uint8_t>>> m_Values;
+    // The number of entries from which the released values are pruned, twice the values alive after the last prune
+    std::size_t                                                    m_PruneThreshold;
+    std::atomic<std::size_t>                                       m_NumReusedPermutedBytes;
+};
+
+/// Returns the store shared by all the models converted by the driver process
+ConstTensorStore& GetConstTensorStore();
+
+} // namespace armnn_driver
@@ -49,18 +49,22 @@ ConstTensorPin::ConstTensorPin(bool optional)
 ConstTensorPin::ConstTensorPin(const armnn::TensorInfo& tensorInfo,
                                const void* valueStart,
                                uint32_t numBytes,
-                               const armnn::PermutationVector& mappings)
+                               const armnn::PermutationVector& mappings,
+                               bool permuteValues)
 {
     boost::ignore_unused(numBytes);
     assert(tensorInfo.GetNumBytes() == numBytes);
 
     const bool needsSwizzling = (mappings.GetSize() > 0);
-    if (needsSwizzling)
+    if (needsSwizzling && !permuteValues)
     {
-        m_SwizzledTensorData.resize(tensorInfo.GetNumBytes());
-        SwizzleAndroidNn4dTensorToArmNn(tensorInfo, valueStart, m_SwizzledTensorData.data(), mappings);
+        m_ConstTensor = armnn::ConstTensor(armnnUtils::Permuted(tensorInfo, mappings), valueStart);
+    }
+    else if (needsSwizzling)
+    {
+        m_SwizzledTensorData = GetConstTensorStore().GetPermuted(tensorInfo, valueStart, mappings);
 
-        m_ConstTensor = armnn::ConstTensor(armnnUtils::Permuted(tensorInfo, mappings), m_SwizzledTensorData.data());
+        m_ConstTensor = armnn::ConstTensor(armnnUtils::Permuted(tensorInfo, mappings), m_SwizzledTensorData->data());
     }
     else
     {
@@ -169,4 +173,15 @@ armnn::IConnectableLayer* ProcessActivation(const armnn::TensorInfo& tensorInfo,
     return activationLayer;
 }
 
+armnn::IConnectableLayer* AddDryRunPlaceholderLayer(ConversionData& data)
+{
+    BOOST_ASSERT(data.m_Mode == ConversionMode::DryRun);
+
+    armnn::ActivationDescriptor desc;
+    desc.m_Function = armnn::ActivationFunction::Linear;
+    desc.m_A = 1.0f;
+    desc.m_B = 0.0f;
+    return data.m_Network->AddActivationLayer(desc, "DryRunPlaceholder");
+}
+
 } // namespace armnn_driver
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <armnn/ArmNN.hpp>
 
 #include "armnn/src/armnnUtils/Permute.hpp"
+#include "ConstTensorStore.hpp"
 #include "Utils.hpp"
 
 #include <ActivationFunctor.h>
@@ -27,14 +28,24 @@ namespace armnn_driver
 /// Helper classes
 ///
 
+/// How a model is converted
+enum class ConversionMode
+{
+    Network,    // to an INetwork that can be optimized and loaded
+    DryRun      // only to find which operations are supported: the constant tensors are neither permuted nor copied
+                // into the network, which is incomplete and must not be used
+};
+
 struct ConversionData
 {
-    ConversionData(armnn::Compute compute)
+    ConversionData(armnn::Compute compute, ConversionMode mode = ConversionMode::Network)
             : m_Compute(compute)
+            , m_Mode(mode)
             , m_Network(nullptr, nullptr)
     {}
 
     const armnn::Compute                      m_Compute;
+    const ConversionMode                      m_Mode;
     armnn::INetworkPtr                        m_Network;
     std::vector<armnn::IOutputSlot*>          m_OutputSlotForOperand;
     std::vector<android::nn::RunTimePoolInfo> m_MemPools;
@@ -69,8 +80,10 @@ public:
     // @param valueStart Start address of tensor data. Belongs to one of the memory pools associated with
     // the model being converted.
     // @param numBytes Number of bytes for the tensor data.
+    // @param permuteValues If false, the tensor info is permuted but the tensor references the values in their
+    // original order, which is enough to check whether the layers using it are supported.
     ConstTensorPin(const armnn::TensorInfo& tensorInfo, const void* valueStart, uint32_t numBytes,
-                   const armnn::PermutationVector& mappings);
+                   const armnn::PermutationVector& mappings, bool permuteValues = true);
 
     ConstTensorPin(const ConstTensorPin& other) = delete;
     ConstTensorPin(ConstTensorPin&& other)      = default;
@@ -84,10 +97,10 @@ public:
 private:
     armnn::ConstTensor m_ConstTensor;
 
-    // Owned memory for swizzled tensor data, only required if the tensor needed
-    // swizzling. Otherwise, @ref m_ConstTensor will reference memory from one of
-    // the pools associated with the model being converted.
-    std::vector<uint8_t> m_SwizzledTensorData;
+    // Memory for swizzled tensor data, only required if the tensor needed swizzling, shared through the
+    // ConstTensorStore with the pins of identical tensors. Otherwise, @ref m_ConstTensor will reference
+    // memory from one of the pools associated with the model being converted.
+    ConstTensorStore::Values m_SwizzledTensorData;
 
     // optional flag to indicate that an invalid tensor pin is not an error, but the optional values were not given
     bool m_Optional;
@@ -431,6 +444,10 @@ armnn::IConnectableLayer* ProcessActivation(const armnn::TensorInfo& tensorInfo,
                                             armnn::IConnectableLayer* prevLayer,
                                             ConversionData& data);
 
+//// In a dry run, adds a layer without constant tensors standing in for a layer that has some, with one input and
+//// one output slot. The layers using its output are checked for support as if it was the layer it replaces.
+armnn::IConnectableLayer* AddDryRunPlaceholderLayer(ConversionData& data);
+
 } // namespace armnn_driver
 
 ///
@@ -512,7 +529,11 @@ ConstTensorPin ConvertOperandToConstTensorPin(const Operand& operand,
     {
         tensorInfo.SetShape(*overrideTensorShape);
     }
-    return ConstTensorPin(tensorInfo, valueStart, operand.location.length, dimensionMappings);
+    return ConstTensorPin(tensorInfo,
+                          valueStart,
+                          operand.location.length,
+                          dimensionMappings,
+                          data.m_Mode != ConversionMode::DryRun);
 }
 
 template<typename HalOperation, typename HalModel>
@@ -804,7 +825,9 @@ LayerInputHandle ConvertToLayerInputHandle(const HalOperation& operation,
                     return LayerInputHandle();
                 }
 
-                armnn::IConnectableLayer* constantLayer = data.m_Network->AddConstantLayer(tensorPin.GetConstTensor());
+                armnn::IConnectableLayer* constantLayer = data.m_Mode == ConversionMode::DryRun ?
+                    AddDryRunPlaceholderLayer(data) :
+                    data.m_Network->AddConstantLayer(tensorPin.GetConstTensor());
                 armnn::IOutputSlot& outputSlot = constantLayer->GetOutputSlot(0);
                 outputSlot.SetTensorInfo(tensorPin.GetConstTensor().GetInfo());
 
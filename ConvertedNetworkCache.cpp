@@ -0,0 +1,101 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "ConvertedNetworkCache.hpp"
+
+#include <log/log.h>
+
+namespace armnn_driver
+{
+
+ConvertedNetworkCache::ConvertedNetworkCache(std::size_t capacity, Clock::duration timeToLive)
+    : m_Capacity(capacity)
+    , m_TimeToLive(timeToLive)
+    , m_NumHits(0)
+    , m_NumMisses(0)
+{
+}
+
+void ConvertedNetworkCache::Insert(const ModelHash& hash, armnn::INetworkPtr network)
+{
+    if (!IsEnabled() || !network)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    RemoveExpired();
+
+    // A model queried again replaces its previous network
+    for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+    {
+        if (it->m_Hash == hash)
+        {
+            m_Entries.erase(it);
+            break;
+        }
+    }
+
+    if (m_Entries.size() == m_Capacity)
+    {
+        m_Entries.pop_front();
+    }
+    m_Entries.push_back({ hash, std::move(network), Clock::now() + m_TimeToLive });
+}
+
+armnn::INetworkPtr ConvertedNetworkCache::Take(const ModelHash& hash)
+{
+    armnn::INetworkPtr network(nullptr, nullptr);
+    if (!IsEnabled())
+    {
+        return network;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        RemoveExpired();
+
+        for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+        {
+            if (it->m_Hash == hash)
+            {
+                network = std::move(it->m_Network);
+                m_Entries.erase(it);
+                break;
+            }
+        }
+    }
+
+    if (network)
+    {
+        ++m_NumHits;
+        ALOGV("ConvertedNetworkCache: reusing the network converted for model %s", ModelHashToString(hash).c_str());
+    }
+    else
+    {
+        ++m_NumMisses;
+    }
+    return network;
+}
+
+std::size_t ConvertedNetworkCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Entries.size();
+}
+
+void ConvertedNetworkCache::RemoveExpired()
+{
+    // The entries are inserted in order of expiry
+    const Clock::time_point now = Clock::now();
+    while (!m_Entries.empty() && m_Entries.front().m_Expiry <= now)
+    {
+        m_Entries.pop_front();
+    }
+}
+
+} // namespace armnn_driver
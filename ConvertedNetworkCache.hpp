@@ -0,0 +1,75 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "ModelHash.hpp"
+
+#include <armnn/ArmNN.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <mutex>
+
+namespace armnn_driver
+{
+
+/// The networks converted by getSupportedOperations for the models whose operations are all supported, kept for a
+/// short time so that prepareModel, which the NN runtime calls next with the same model, optimizes them directly
+/// rather than converting the model again. The networks are identified by the hash of the model and of the compute
+/// device. Only the most recent networks are kept, and the expired ones are dropped whenever the cache is used.
+/// All the methods can be called from any thread.
+class ConvertedNetworkCache
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @param[in] capacity the maximum number of networks kept, 0 disables the cache
+    /// @param[in] timeToLive how long a network is kept if prepareModel is not called for its model
+    ConvertedNetworkCache(std::size_t capacity, Clock::duration timeToLive);
+
+    bool IsEnabled() const { return m_Capacity > 0; }
+
+    /// Keeps the network converted for the given hash, dropping the oldest network if the cache is full
+    void Insert(const ModelHash& hash, armnn::INetworkPtr network);
+
+    /// Removes and returns the network converted for the given hash, nullptr if there is none
+    armnn::INetworkPtr Take(const ModelHash& hash);
+
+    /// Returns the number of networks kept
+    std::size_t GetSize() const;
+
+    /// Returns the number of calls to Take that returned a network, for testing
+    std::size_t GetNumHits() const { return m_NumHits.load(); }
+
+    /// Returns the number of calls to Take that returned nullptr, for testing
+    std::size_t GetNumMisses() const { return m_NumMisses.load(); }
+
+private:
+    ConvertedNetworkCache(const ConvertedNetworkCache&) = delete;
+    ConvertedNetworkCache& operator=(const ConvertedNetworkCache&) = delete;
+
+    struct Entry
+    {
+        ModelHash          m_Hash;
+        armnn::INetworkPtr m_Network;
+        Clock::time_point  m_Expiry;
+    };
+
+    // Must be called with the mutex locked
+    void RemoveExpired();
+
+    const std::size_t        m_Capacity;
+    const Clock::duration    m_TimeToLive;
+    mutable std::mutex       m_Mutex;
+    // From the oldest to the most recent
+    std::list<Entry>         m_Entries;
+    std::atomic<std::size_t> m_NumHits;
+    std::atomic<std::size_t> m_NumMisses;
+};
+
+} // namespace armnn_driver
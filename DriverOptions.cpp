@@ -33,6 +33,20 @@ DriverOptions::DriverOptions(armnn::Compute computeDevice, bool fp16Enabled)
     , m_ClTunedParametersMode(armnn::IGpuAccTunedParameters::Mode::UseTunedParameters)
     , m_EnableGpuProfiling(false)
     , m_fp16Enabled(fp16Enabled)
+    , m_NumberOfRequestThreads(1)
+    , m_NumberOfBinderThreads(1)
+    , m_MaxBatchSize(1)
+    , m_MaxBatchWaitMicroseconds(1000)
+    , m_LatencyLogPeriod(0)
+    , m_MaxPendingRequests(0)
+    , m_MaxPendingRequestsPerModel(0)
+    , m_PendingRequestsTimeoutMs(0)
+    , m_NumberOfPrepareThreads(0)
+    , m_MaxQueuedPrepares(16)
+    , m_WarmUpPolicy(WarmUpPolicy::Always)
+    , m_ConvertedNetworkCacheSize(0)
+    , m_MaxConvertedNetworkMb(16)
+    , m_LoadedNetworksBudgetMb(0)
 {
 }
 
@@ -42,12 +56,28 @@ DriverOptions::DriverOptions(int argc, char** argv)
     , m_ClTunedParametersMode(armnn::IGpuAccTunedParameters::Mode::UseTunedParameters)
     , m_EnableGpuProfiling(false)
     , m_fp16Enabled(false)
+    , m_NumberOfRequestThreads(1)
+    , m_NumberOfBinderThreads(1)
+    , m_MaxBatchSize(1)
+    , m_MaxBatchWaitMicroseconds(1000)
+    , m_LatencyLogPeriod(0)
+    , m_MaxPendingRequests(0)
+    , m_MaxPendingRequestsPerModel(0)
+    , m_PendingRequestsTimeoutMs(0)
+    , m_NumberOfPrepareThreads(0)
+    , m_MaxQueuedPrepares(16)
+    , m_WarmUpPolicy(WarmUpPolicy::Always)
+    , m_ConvertedNetworkCacheSize(0)
+    , m_MaxConvertedNetworkMb(16)
+    , m_LoadedNetworksBudgetMb(0)
 {
     namespace po = boost::program_options;
 
     std::string computeDeviceAsString;
     std::string unsupportedOperationsAsString;
     std::string clTunedParametersModeAsString;
+    std::string requestThreadCpusAsString;
+    std::string warmUpPolicyAsString;
 
     po::options_description optionsDesc("Options");
     optionsDesc.add_options()
@@ -86,7 +116,111 @@ DriverOptions::DriverOptions(int argc, char** argv)
 
         ("fp16-enabled,f",
          po::bool_switch(&m_fp16Enabled),
-         "Enables support for relaxed computation from Float32 to Float16");
+         "Enables support for relaxed computation from Float32 to Float16")
+
+        ("request-threads",
+         po::value<unsigned int>(&m_NumberOfRequestThreads)->default_value(1),
+         "The number of threads used to execute requests. Requests for the same prepared model are always "
+         "executed in order by a single thread, but different models can be executed in parallel. "
+         "Only supported with the CpuRef and CpuAcc compute devices, GpuAcc always uses a single thread.")
+
+        ("binder-threads",
+         po::value<unsigned int>(&m_NumberOfBinderThreads)->default_value(1),
+         "The number of threads serving the calls of the clients. With more than one thread, preparing a model "
+         "does not block the requests of other clients. Defaults to the single thread of the libhidl threadpool.")
+
+        ("max-batch-size",
+         po::value<unsigned int>(&m_MaxBatchSize)->default_value(1),
+         "The maximum number of pending requests for the same prepared model that are executed together, "
+         "stacked along the batch dimension. Only models whose operations process each batch element "
+         "independently are batched. A value of 1 disables batching.")
+
+        ("max-batch-wait-us",
+         po::value<unsigned int>(&m_MaxBatchWaitMicroseconds)->default_value(1000),
+         "The maximum time in microseconds to wait for more requests to fill a batch, "
+         "when batching is enabled with --max-batch-size. Models prepared for fast single answers "
+         "do not wait, they are only batched with the requests already queued.")
+
+        ("latency-log-period",
+         po::value<unsigned int>(&m_LatencyLogPeriod)->default_value(0),
+         "The number of requests between two summaries of the request latencies of a prepared model written "
+         "to the log. A value of 0 disables the summaries. The latencies are also written to "
+         "<network id>_<prepared model id>_latency.json in the --request-inputs-and-outputs-dump-dir directory, "
+         "if set.")
+
+        ("request-thread-cpus",
+         po::value<std::string>(&requestThreadCpusAsString)->default_value(""),
+         "The CPUs the request threads may run on, as a comma separated list of indexes and ranges, "
+         "e.g. 4-7 for the big cores of a big.LITTLE device. By default the threads may run on any CPU.")
+
+        ("request-thread-nice",
+         po::value<int>(&m_RequestThreadScheduling.m_Nice)->default_value(0),
+         "The nice value of the request threads, from -20 (highest priority) to 19. "
+         "A value of 0 leaves the priority unchanged.")
+
+        ("request-thread-fifo-priority",
+         po::value<unsigned int>(&m_RequestThreadScheduling.m_FifoPriority)->default_value(0),
+         "Runs the request threads with the SCHED_FIFO real-time policy and the given priority, from 1 to 99. "
+         "A value of 0 keeps the default time-sharing policy.")
+
+        ("max-pending-requests",
+         po::value<unsigned int>(&m_MaxPendingRequests)->default_value(0),
+         "The maximum number of requests submitted to the driver and not completed yet, for all the prepared "
+         "models. Further requests are rejected with DEVICE_UNAVAILABLE, after waiting for "
+         "--pending-requests-timeout-ms. A value of 0 sets no limit.")
+
+        ("max-pending-requests-per-model",
+         po::value<unsigned int>(&m_MaxPendingRequestsPerModel)->default_value(0),
+         "The maximum number of requests submitted and not completed yet for each prepared model. "
+         "A value of 0 sets no limit.")
+
+        ("pending-requests-timeout-ms",
+         po::value<unsigned int>(&m_PendingRequestsTimeoutMs)->default_value(0),
+         "How long a request waits for pending requests to complete when a limit on the number of pending "
+         "requests is reached, before it is rejected. A value of 0 rejects it immediately.")
+
+        ("cache-dir",
+         po::value<std::string>(&m_CacheDir)->default_value(""),
+         "If non-empty, the directory where the OpenCL programs compiled when preparing models on GpuAcc are "
+         "saved, and restored from when the driver restarts, so that they are not compiled again.")
+
+        ("prepare-threads",
+         po::value<unsigned int>(&m_NumberOfPrepareThreads)->default_value(0),
+         "The number of threads preparing models in the background. If non-zero, prepareModel returns as soon as "
+         "the model is validated, and notifies the client once the model is prepared. By default, the models are "
+         "prepared before prepareModel returns. GpuAcc only supports one thread.")
+
+        ("max-queued-prepares",
+         po::value<unsigned int>(&m_MaxQueuedPrepares)->default_value(16),
+         "The maximum number of models waiting for a thread of --prepare-threads. Further models are prepared "
+         "before prepareModel returns. A value of 0 sets no limit.")
+
+        ("warm-up",
+         po::value<std::string>(&warmUpPolicyAsString)->default_value("Always"),
+         "When prepared models are warmed up with an inference on dummy inputs, which compiles the CL kernels "
+         "before the first request. If 'Always' (the default), before the client is notified that the model is "
+         "prepared. If 'Deferred', in the background once the client is notified. If 'Never', the first request "
+         "compiles the kernels. Models are always warmed up before being notified when updating the CL tuned "
+         "parameters, as tuning requires an inference.")
+
+        ("converted-network-cache-size",
+         po::value<unsigned int>(&m_ConvertedNetworkCacheSize)->default_value(0),
+         "The maximum number of networks converted by getSupportedOperations that are kept for a few seconds, "
+         "so that prepareModel does not convert the same model again. Only the models whose operations are all "
+         "supported are kept. A value of 0, the default, disables the cache.")
+
+        ("max-converted-network-mb",
+         po::value<unsigned int>(&m_MaxConvertedNetworkMb)->default_value(16),
+         "The maximum size in MB of the constant tensors of a model for getSupportedOperations to convert it "
+         "to a network kept for prepareModel, see --converted-network-cache-size. The supported operations of "
+         "larger models, or of every model if the cache is disabled, are found with a dry run that neither copies "
+         "nor permutes the constant tensors.")
+
+        ("loaded-networks-budget-mb",
+         po::value<unsigned int>(&m_LoadedNetworksBudgetMb)->default_value(0),
+         "The memory in MB the networks loaded in the runtime may use, estimated from the size of their constant "
+         "tensors. Beyond it the networks not executing are unloaded, least recently used first, and loaded again "
+         "the next time their prepared models execute. A value of 0 keeps every network loaded.");
 
     po::variables_map variablesMap;
     try
@@ -117,6 +251,76 @@ DriverOptions::DriverOptions(int argc, char** argv)
             computeDeviceAsString.c_str(), GetComputeDeviceAsCString(m_ComputeDevice));
     }
 
+    if (warmUpPolicyAsString == "Always")
+    {
+        m_WarmUpPolicy = WarmUpPolicy::Always;
+    }
+    else if (warmUpPolicyAsString == "Never")
+    {
+        m_WarmUpPolicy = WarmUpPolicy::Never;
+    }
+    else if (warmUpPolicyAsString == "Deferred")
+    {
+        m_WarmUpPolicy = WarmUpPolicy::Deferred;
+    }
+    else
+    {
+        ALOGW("Requested unknown warm-up policy %s. Defaulting to Always", warmUpPolicyAsString.c_str());
+    }
+
+    if (m_NumberOfRequestThreads == 0)
+    {
+        ALOGW("Requested zero request threads. Defaulting to 1");
+        m_NumberOfRequestThreads = 1;
+    }
+    else if (m_NumberOfRequestThreads > 1 && m_ComputeDevice == armnn::Compute::GpuAcc)
+    {
+        // Workloads submitted to the GPU share a single CL command queue, so they must be executed serially
+        ALOGW("Requested %u request threads, but GpuAcc only supports one. Defaulting to 1",
+              m_NumberOfRequestThreads);
+        m_NumberOfRequestThreads = 1;
+    }
+
+    if (m_NumberOfPrepareThreads > 1 && m_ComputeDevice == armnn::Compute::GpuAcc)
+    {
+        // Preparing several models at once would run their CL warm-ups and tunings side by side on the GPU
+        ALOGW("Requested %u prepare threads, but GpuAcc only supports one. Defaulting to 1",
+              m_NumberOfPrepareThreads);
+        m_NumberOfPrepareThreads = 1;
+    }
+
+    if (m_NumberOfBinderThreads == 0)
+    {
+        ALOGW("Requested zero binder threads. Defaulting to 1");
+        m_NumberOfBinderThreads = 1;
+    }
+
+    if (m_MaxBatchSize == 0)
+    {
+        ALOGW("Requested a maximum batch size of zero. Defaulting to 1");
+        m_MaxBatchSize = 1;
+    }
+
+    if (!requestThreadCpusAsString.empty() &&
+        !ParseCpuList(requestThreadCpusAsString, m_RequestThreadScheduling.m_Cpus))
+    {
+        ALOGW("Ignoring invalid --request-thread-cpus value: %s", requestThreadCpusAsString.c_str());
+    }
+
+    if (m_RequestThreadScheduling.m_Nice < -20 || m_RequestThreadScheduling.m_Nice > 19)
+    {
+        ALOGW("Requested a nice value of %d for the request threads. Leaving it unchanged",
+              m_RequestThreadScheduling.m_Nice);
+        m_RequestThreadScheduling.m_Nice = 0;
+    }
+
+    if (m_RequestThreadScheduling.m_FifoPriority > 99)
+    {
+        ALOGW("Requested a SCHED_FIFO priority of %u for the request threads. Defaulting to 99",
+              m_RequestThreadScheduling.m_FifoPriority);
+        m_RequestThreadScheduling.m_FifoPriority = 99;
+    }
+
     if (!unsupportedOperationsAsString.empty())
     {
         std::istringstream argStream(unsupportedOperationsAsString);
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "ThreadScheduling.hpp"
+
 #include <armnn/ArmNN.hpp>
 
 #include <set>
@@ -13,6 +15,15 @@
 namespace armnn_driver
 {
 
+/// When a model is warmed up with an inference on dummy inputs, which compiles its CL kernels before the first
+/// request is executed
+enum class WarmUpPolicy
+{
+    Always,     // before the client is notified that the model is prepared
+    Never,      // the first request compiles the kernels
+    Deferred    // in the background, after the client is notified
+};
+
 class DriverOptions
 {
 public:
@@ -28,6 +39,22 @@ public:
     armnn::IGpuAccTunedParameters::Mode GetClTunedParametersMode() const { return m_ClTunedParametersMode; }
     bool IsGpuProfilingEnabled() const { return m_EnableGpuProfiling; }
     bool GetFp16Enabled() const { return m_fp16Enabled; }
+    unsigned int GetNumberOfRequestThreads() const { return m_NumberOfRequestThreads; }
+    unsigned int GetNumberOfBinderThreads() const { return m_NumberOfBinderThreads; }
+    unsigned int GetMaxBatchSize() const { return m_MaxBatchSize; }
+    unsigned int GetMaxBatchWaitMicroseconds() const { return m_MaxBatchWaitMicroseconds; }
+    unsigned int GetLatencyLogPeriod() const { return m_LatencyLogPeriod; }
+    const ThreadSchedulingPolicy& GetRequestThreadScheduling() const { return m_RequestThreadScheduling; }
+    unsigned int GetMaxPendingRequests() const { return m_MaxPendingRequests; }
+    unsigned int GetMaxPendingRequestsPerModel() const { return m_MaxPendingRequestsPerModel; }
+    unsigned int GetPendingRequestsTimeoutMs() const { return m_PendingRequestsTimeoutMs; }
+    const std::string& GetCacheDir() const { return m_CacheDir; }
+    unsigned int GetNumberOfPrepareThreads() const { return m_NumberOfPrepareThreads; }
+    unsigned int GetMaxQueuedPrepares() const { return m_MaxQueuedPrepares; }
+    WarmUpPolicy GetWarmUpPolicy() const { return m_WarmUpPolicy; }
+    unsigned int GetConvertedNetworkCacheSize() const { return m_ConvertedNetworkCacheSize; }
+    unsigned int GetMaxConvertedNetworkMb() const { return m_MaxConvertedNetworkMb; }
+    unsigned int GetLoadedNetworksBudgetMb() const { return m_LoadedNetworksBudgetMb; }
 
 private:
     armnn::Compute m_ComputeDevice;
@@ -38,6 +65,22 @@ private:
     armnn::IGpuAccTunedParameters::Mode m_ClTunedParametersMode;
     bool m_EnableGpuProfiling;
     bool m_fp16Enabled;
+    unsigned int m_NumberOfRequestThreads;
+    unsigned int m_NumberOfBinderThreads;
+    unsigned int m_MaxBatchSize;
+    unsigned int m_MaxBatchWaitMicroseconds;
+    unsigned int m_LatencyLogPeriod;
+    ThreadSchedulingPolicy m_RequestThreadScheduling;
+    unsigned int m_MaxPendingRequests;
+    unsigned int m_MaxPendingRequestsPerModel;
+    unsigned int m_PendingRequestsTimeoutMs;
+    std::string m_CacheDir;
+    unsigned int m_NumberOfPrepareThreads;
+    unsigned int m_MaxQueuedPrepares;
+    WarmUpPolicy m_WarmUpPolicy;
+    unsigned int m_ConvertedNetworkCacheSize;
+    unsigned int m_MaxConvertedNetworkMb;
+    unsigned int m_LoadedNetworksBudgetMb;
 };
 
 } // namespace armnn_driver
@@ -0,0 +1,121 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "LoadedNetworkBudget.hpp"
+#include "PreparedNetworkCache.hpp"
+
+#include <log/log.h>
+
+namespace armnn_driver
+{
+
+LoadedNetworkBudget::LoadedNetworkBudget(std::size_t budget)
+    : m_Budget(budget)
+    , m_LoadedBytes(0)
+    , m_NumEvictions(0)
+    , m_NumReloads(0)
+    , m_TotalReloadTimeUs(0)
+{
+}
+
+void LoadedNetworkBudget::Add(SharedNetwork& network)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto found = m_Index.find(&network);
+    if (found != m_Index.end())
+    {
+        m_Networks.splice(m_Networks.begin(), m_Networks, found->second);
+    }
+    else
+    {
+        m_Networks.push_front(&network);
+        m_Index.emplace(&network, m_Networks.begin());
+        m_LoadedBytes += network.GetSize();
+    }
+
+    // The networks executing are skipped rather than waited for, they are the most likely to be executed again
+    auto it = m_Networks.end();
+    while (m_LoadedBytes > m_Budget && it != m_Networks.begin())
+    {
+        --it;
+        SharedNetwork* candidate = *it;
+        if (candidate == &network || !candidate->TryEvict())
+        {
+            continue;
+        }
+
+        ALOGV("LoadedNetworkBudget: unloaded a network of %zu KB", candidate->GetSize() / 1024);
+        m_LoadedBytes -= candidate->GetSize();
+        m_Index.erase(candidate);
+        it = m_Networks.erase(it);
+        ++m_NumEvictions;
+    }
+
+    if (m_LoadedBytes > m_Budget)
+    {
+        ALOGW("LoadedNetworkBudget: the %zu networks loaded use %zu KB, over the budget of %zu KB",
+              m_Networks.size(), m_LoadedBytes / 1024, m_Budget / 1024);
+    }
+}
+
+void LoadedNetworkBudget::Touch(SharedNetwork& network)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Index.find(&network);
+    if (it != m_Index.end())
+    {
+        m_Networks.splice(m_Networks.begin(), m_Networks, it->second);
+    }
+}
+
+void LoadedNetworkBudget::Remove(SharedNetwork& network)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Index.find(&network);
+    if (it != m_Index.end())
+    {
+        m_LoadedBytes -= network.GetSize();
+        m_Networks.erase(it->second);
+        m_Index.erase(it);
+    }
+}
+
+void LoadedNetworkBudget::RecordReload(Clock::duration duration)
+{
+    ++m_NumReloads;
+    m_TotalReloadTimeUs += std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+std::size_t LoadedNetworkBudget::GetNumLoadedNetworks() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Networks.size();
+}
+
+std::size_t LoadedNetworkBudget::GetLoadedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_LoadedBytes;
+}
+
+} // namespace armnn_driver
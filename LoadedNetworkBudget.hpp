@@ -0,0 +1,78 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace armnn_driver
+{
+
+class SharedNetwork;
+
+/// Limits the memory used by the networks loaded in the runtime. Applications often keep prepared models they no
+/// longer execute, so once the loaded networks exceed the budget the least recently executed ones are unloaded,
+/// and loaded again by the next execution of their prepared models, see SharedNetwork::Load. The memory of a
+/// network is estimated from the size of its constant tensors. All the methods can be called from any thread.
+class LoadedNetworkBudget
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @param[in] budget the memory in bytes the loaded networks may use, 0 for no limit
+    explicit LoadedNetworkBudget(std::size_t budget);
+
+    /// Returns false if the networks are never unloaded before their prepared models are released
+    bool IsEnabled() const { return m_Budget != 0; }
+
+    /// Records that a network was loaded, then unloads the least recently used networks that are not executing until
+    /// the loaded networks fit the budget. The given network is never unloaded, even if it exceeds the budget alone.
+    void Add(SharedNetwork& network);
+
+    /// Marks a loaded network as the most recently used
+    void Touch(SharedNetwork& network);
+
+    /// Forgets a network that is being destroyed
+    void Remove(SharedNetwork& network);
+
+    /// Records how long loading an unloaded network again took
+    void RecordReload(Clock::duration duration);
+
+    /// Returns the number of networks loaded, and their estimated memory in bytes
+    std::size_t GetNumLoadedNetworks() const;
+    std::size_t GetLoadedBytes() const;
+
+    /// Returns the number of networks unloaded to fit the budget
+    std::size_t GetNumEvictions() const { return m_NumEvictions.load(); }
+
+    /// Returns the number of networks loaded again after being unloaded, and the total time it took
+    std::size_t GetNumReloads() const { return m_NumReloads.load(); }
+    std::chrono::microseconds GetTotalReloadTime() const
+    {
+        return std::chrono::microseconds(m_TotalReloadTimeUs.load());
+    }
+
+private:
+    LoadedNetworkBudget(const LoadedNetworkBudget&) = delete;
+    LoadedNetworkBudget& operator=(const LoadedNetworkBudget&) = delete;
+
+    const std::size_t                                             m_Budget;
+    mutable std::mutex                                            m_Mutex;
+    // From the most to the least recently used
+    std::list<SharedNetwork*>                                     m_Networks;
+    std::map<SharedNetwork*, std::list<SharedNetwork*>::iterator> m_Index;
+    std::size_t                                                   m_LoadedBytes;
+    std::atomic<std::size_t>                                      m_NumEvictions;
+    std::atomic<std::size_t>                                      m_NumReloads;
+    std::atomic<int64_t>                                          m_TotalReloadTimeUs;
+};
+
+} // namespace armnn_driver
@@ -0,0 +1,174 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "MemoryPoolCache.hpp"
+#include "Utils.hpp"
+
+#include <log/log.h>
+
+#include <sys/stat.h>
+
+#include <cstring>
+
+namespace armnn_driver
+{
+
+MemoryPoolCache::MemoryPoolCache(std::size_t capacity)
+    : m_Capacity(capacity)
+    , m_NumHits(0)
+    , m_NumMisses(0)
+{
+}
+
+bool MemoryPoolCache::GetRunTimePoolInfos(const hidl_vec<hidl_memory>& pools,
+                                          std::vector<std::shared_ptr<android::nn::RunTimePoolInfo>>& poolInfos)
+{
+    poolInfos.clear();
+    for (const hidl_memory& pool : pools)
+    {
+        std::shared_ptr<android::nn::RunTimePoolInfo> poolInfo = GetRunTimePoolInfo(pool);
+        if (!poolInfo)
+        {
+            ALOGE("MemoryPoolCache::GetRunTimePoolInfos: could not map pool");
+            poolInfos.clear();
+            return false;
+        }
+        poolInfos.push_back(std::move(poolInfo));
+    }
+    return true;
+}
+
+void MemoryPoolCache::Clear()
+{
+    std::list<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        entries.swap(m_Entries);
+    }
+    // The pools are unmapped here, outside the lock, unless a request in flight still uses them
+    ALOGV("MemoryPoolCache::Clear(): dropping %zu pool(s)", entries.size());
+}
+
+std::size_t MemoryPoolCache::GetNumHits() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_NumHits;
+}
+
+std::size_t MemoryPoolCache::GetNumMisses() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_NumMisses;
+}
+
+bool MemoryPoolCache::GetKey(const hidl_memory& memory, Key& key)
+{
+    const native_handle_t* handle = memory.handle();
+    if (handle == nullptr || handle->numFds < 1 || memory.name() != "mmap_fd")
+    {
+        return false;
+    }
+
+    // The ints of an "mmap_fd" handle hold the protection and the offset of the mapping, split in two halves,
+    // as read by RunTimePoolInfo
+    if (handle->numInts < 3)
+    {
+        ALOGW("MemoryPoolCache: mmap_fd handle has %d ints, not caching it", handle->numInts);
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(handle->data[0], &fileStat) != 0)
+    {
+        ALOGW("MemoryPoolCache: fstat failed: %s", strerror(errno));
+        return false;
+    }
+
+    // The inodes of other files, e.g. devices, do not identify the memory mapped
+    if (!S_ISREG(fileStat.st_mode))
+    {
+        return false;
+    }
+
+    key.m_Device = fileStat.st_dev;
+    key.m_Inode  = fileStat.st_ino;
+    key.m_Size   = memory.size();
+    key.m_Prot   = handle->data[1];
+    key.m_Offset = (static_cast<uint64_t>(static_cast<uint32_t>(handle->data[3])) << 32) |
+                   static_cast<uint32_t>(handle->data[2]);
+    return true;
+}
+
+bool MemoryPoolCache::Matches(const Key& key, const Key& other)
+{
+    return key.m_Device == other.m_Device &&
+           key.m_Inode  == other.m_Inode  &&
+           key.m_Size   == other.m_Size   &&
+           key.m_Offset == other.m_Offset &&
+           key.m_Prot   == other.m_Prot;
+}
+
+std::shared_ptr<android::nn::RunTimePoolInfo> MemoryPoolCache::GetRunTimePoolInfo(const hidl_memory& memory)
+{
+    Key key;
+    if (m_Capacity == 0 || !GetKey(memory, key))
+    {
+        return MapRunTimePoolInfo(memory);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::shared_ptr<android::nn::RunTimePoolInfo> cached = Find(key);
+        if (cached)
+        {
+            ++m_NumHits;
+            return cached;
+        }
+        ++m_NumMisses;
+    }
+
+    // Map the pool outside the lock, as this involves system calls
+    std::shared_ptr<android::nn::RunTimePoolInfo> poolInfo = MapRunTimePoolInfo(memory);
+    if (!poolInfo)
+    {
+        return nullptr;
+    }
+
+    std::list<Entry> evicted;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        // Another request may have mapped the same pool in the meantime
+        std::shared_ptr<android::nn::RunTimePoolInfo> cached = Find(key);
+        if (cached)
+        {
+            return cached;
+        }
+        m_Entries.push_front(Entry{ std::move(key), poolInfo });
+        while (m_Entries.size() > m_Capacity)
+        {
+            // Unmap the least recently used pools outside the lock
+            evicted.splice(evicted.begin(), m_Entries, std::prev(m_Entries.end()));
+        }
+    }
+    return poolInfo;
+}
+
+std::shared_ptr<android::nn::RunTimePoolInfo> MemoryPoolCache::Find(const Key& key)
+{
+    for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+    {
+        if (Matches(it->m_Key, key))
+        {
+            // Move the entry to the front, this does not allocate
+            m_Entries.splice(m_Entries.begin(), m_Entries, it);
+            return it->m_PoolInfo;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace armnn_driver
@@ -0,0 +1,82 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <HalInterfaces.h>
+#include <CpuExecutor.h>
+
+#include <sys/types.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// A least-recently-used cache of mapped request memory pools.
+/// Clients typically reuse the same input and output buffers for every request, so keeping their mappings
+/// avoids mapping and unmapping each pool on every execution. The hidl_memory objects received with each
+/// request carry new file descriptors, so the pools are identified by the file they refer to. Only the "mmap_fd"
+/// pools of regular files are cached: every ashmem region has the inode of the ashmem device, so two regions of the
+/// same size could not be told apart. The cached mapping keeps the file alive, so its inode is not reused meanwhile.
+class MemoryPoolCache
+{
+public:
+    /// @param[in] capacity the maximum number of mapped pools kept in the cache, 0 disables caching
+    MemoryPoolCache(std::size_t capacity);
+
+    /// Maps the memory pools of a request, reusing the cached mappings where possible.
+    /// Can be called from any thread.
+    /// @param[in] pools the memory pools of the request
+    /// @param[out] poolInfos the mapped pools, in the same order as in the request
+    /// @return false if any of the pools could not be mapped
+    bool GetRunTimePoolInfos(const hidl_vec<hidl_memory>& pools,
+                             std::vector<std::shared_ptr<android::nn::RunTimePoolInfo>>& poolInfos);
+
+    /// Drops all the cached mappings, e.g. when the client owning the memory has died
+    void Clear();
+
+    std::size_t GetNumHits() const;
+    std::size_t GetNumMisses() const;
+
+private:
+    /// Identifies the range of a file mapped by an "mmap_fd" pool, independently of the file descriptor used
+    /// to access it
+    struct Key
+    {
+        dev_t       m_Device;
+        ino_t       m_Inode;
+        uint64_t    m_Size;
+        uint64_t    m_Offset;
+        int         m_Prot;
+    };
+
+    struct Entry
+    {
+        Key                                             m_Key;
+        std::shared_ptr<android::nn::RunTimePoolInfo>   m_PoolInfo;
+    };
+
+    /// @return false if the memory is not an "mmap_fd" pool of a regular file, in which case it is not cached
+    static bool GetKey(const hidl_memory& memory, Key& key);
+    static bool Matches(const Key& key, const Key& other);
+
+    std::shared_ptr<android::nn::RunTimePoolInfo> GetRunTimePoolInfo(const hidl_memory& memory);
+
+    /// Looks up a pool and marks it as the most recently used. Must be called with the mutex held.
+    std::shared_ptr<android::nn::RunTimePoolInfo> Find(const Key& key);
+
+    const std::size_t       m_Capacity;
+    mutable std::mutex      m_Mutex;
+    // Most recently used first
+    std::list<Entry>        m_Entries;
+    std::size_t             m_NumHits;
+    std::size_t             m_NumMisses;
+};
+
+} // namespace armnn_driver
@@ -0,0 +1,197 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "ModelHash.hpp"
+#include "Utils.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+namespace armnn_driver
+{
+
+namespace
+{
+
+void AddOperandsToHash(const android::hardware::hidl_vec<Operand>& operands, ModelHasher& hasher)
+{
+    hasher.AddValue(static_cast<uint64_t>(operands.size()));
+    for (const Operand& operand : operands)
+    {
+        hasher.AddValue(operand.type);
+        hasher.AddVector(operand.dimensions);
+        hasher.AddValue(operand.scale);
+        hasher.AddValue(operand.zeroPoint);
+        hasher.AddValue(operand.lifetime);
+        hasher.AddValue(operand.location.poolIndex);
+        hasher.AddValue(operand.location.offset);
+        hasher.AddValue(operand.location.length);
+    }
+}
+
+template<typename HalOperation>
+void AddOperationsToHash(const android::hardware::hidl_vec<HalOperation>& operations, ModelHasher& hasher)
+{
+    hasher.AddValue(static_cast<uint64_t>(operations.size()));
+    for (const HalOperation& operation : operations)
+    {
+        hasher.AddValue(operation.type);
+        hasher.AddVector(operation.inputs);
+        hasher.AddVector(operation.outputs);
+    }
+}
+
+bool AddPoolsToHash(const android::hardware::hidl_vec<android::hardware::hidl_memory>& pools, ModelHasher& hasher)
+{
+    hasher.AddValue(static_cast<uint64_t>(pools.size()));
+    for (const android::hardware::hidl_memory& pool : pools)
+    {
+        std::shared_ptr<android::nn::RunTimePoolInfo> poolInfo = MapRunTimePoolInfo(pool);
+        if (!poolInfo)
+        {
+            return false;
+        }
+
+        DataLocation location = {};
+        hasher.AddValue(static_cast<uint64_t>(pool.size()));
+        hasher.Add(GetMemoryFromPool(location, *poolInfo), pool.size());
+    }
+    return true;
+}
+
+void AddHalVersionToHash(const V1_0::Model&, ModelHasher& hasher)
+{
+    hasher.AddValue(uint32_t(0x0100));
+}
+
+#ifdef ARMNN_ANDROID_NN_V1_1
+
+void AddHalVersionToHash(const V1_1::Model& model, ModelHasher& hasher)
+{
+    hasher.AddValue(uint32_t(0x0101));
+    hasher.AddValue(model.relaxComputationFloat32toFloat16);
+}
+
+#endif
+
+// The constant operands whose values are part of the signature of an operation, see AddOperationSignatureToHash
+const uint32_t g_MaxSignatureValueBytes = 256;
+
+void AddSignatureOperandsToHash(const android::hardware::hidl_vec<uint32_t>& operandIndexes,
+                                const android::hardware::hidl_vec<Operand>& operands,
+                                const android::hardware::hidl_vec<uint8_t>& operandValues,
+                                const std::vector<android::nn::RunTimePoolInfo>& pools,
+                                ModelHasher& hasher)
+{
+    hasher.AddValue(static_cast<uint64_t>(operandIndexes.size()));
+    for (uint32_t operandIndex : operandIndexes)
+    {
+        // Model should have been validated beforehand
+        const Operand& operand = operands[operandIndex];
+        hasher.AddValue(operand.type);
+        hasher.AddVector(operand.dimensions);
+        hasher.AddValue(operand.scale);
+        hasher.AddValue(operand.zeroPoint);
+        hasher.AddValue(operand.lifetime);
+
+        const void* value = nullptr;
+        if (operand.lifetime == OperandLifeTime::CONSTANT_COPY &&
+            operand.location.offset + operand.location.length <= operandValues.size())
+        {
+            value = operandValues.data() + operand.location.offset;
+        }
+        else if (operand.lifetime == OperandLifeTime::CONSTANT_REFERENCE && operand.location.poolIndex < pools.size())
+        {
+            value = GetMemoryFromPool(operand.location, pools);
+        }
+
+        // Whether an optional constant has a value is part of the signature, even for large tensors
+        hasher.AddValue(value != nullptr);
+        if (value != nullptr && operand.location.length <= g_MaxSignatureValueBytes)
+        {
+            hasher.AddValue(operand.location.length);
+            hasher.Add(value, operand.location.length);
+        }
+    }
+}
+
+} // anonymous namespace
+
+ModelHasher::ModelHasher()
+{
+    SHA256_Init(&m_Context);
+}
+
+void ModelHasher::Add(const void* data, std::size_t size)
+{
+    SHA256_Update(&m_Context, data, size);
+}
+
+ModelHash ModelHasher::GetHash()
+{
+    ModelHash hash;
+    SHA256_Final(hash.data(), &m_Context);
+    return hash;
+}
+
+template<typename HalModel>
+bool AddModelToHash(const HalModel& model, ModelHasher& hasher)
+{
+    AddHalVersionToHash(model, hasher);
+    AddOperandsToHash(model.operands, hasher);
+    AddOperationsToHash(model.operations, hasher);
+    hasher.AddVector(model.inputIndexes);
+    hasher.AddVector(model.outputIndexes);
+
+    hasher.AddValue(static_cast<uint64_t>(model.operandValues.size()));
+    hasher.Add(model.operandValues.data(), model.operandValues.size());
+
+    return AddPoolsToHash(model.pools, hasher);
+}
+
+template<typename HalModel>
+void AddOperationSignatureToHash(const HalModel& model,
+                                 uint32_t operationIndex,
+                                 const std::vector<android::nn::RunTimePoolInfo>& pools,
+                                 ModelHasher& hasher)
+{
+    const auto& operation = model.operations[operationIndex];
+
+    AddHalVersionToHash(model, hasher);
+    hasher.AddValue(operation.type);
+    AddSignatureOperandsToHash(operation.inputs, model.operands, model.operandValues, pools, hasher);
+    AddSignatureOperandsToHash(operation.outputs, model.operands, model.operandValues, pools, hasher);
+}
+
+std::string ModelHashToString(const ModelHash& hash)
+{
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (uint8_t byte : hash)
+    {
+        ss << std::setw(2) << static_cast<unsigned int>(byte);
+    }
+    return ss.str();
+}
+
+///
+/// Class template specializations
+///
+
+template bool AddModelToHash<V1_0::Model>(const V1_0::Model&, ModelHasher&);
+template void AddOperationSignatureToHash<V1_0::Model>(const V1_0::Model&,
+                                                       uint32_t,
+                                                       const std::vector<android::nn::RunTimePoolInfo>&,
+                                                       ModelHasher&);
+
+#ifdef ARMNN_ANDROID_NN_V1_1
+template bool AddModelToHash<V1_1::Model>(const V1_1::Model&, ModelHasher&);
+template void AddOperationSignatureToHash<V1_1::Model>(const V1_1::Model&,
+                                                       uint32_t,
+                                                       const std::vector<android::nn::RunTimePoolInfo>&,
+                                                       ModelHasher&);
+#endif
+
+} // namespace armnn_driver
@@ -0,0 +1,79 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <CpuExecutor.h>
+#include <HalInterfaces.h>
+
+#include <openssl/sha.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// A SHA-256 digest identifying the content of a model
+using ModelHash = std::array<uint8_t, SHA256_DIGEST_LENGTH>;
+
+/// Computes the SHA-256 digest of a sequence of values
+class ModelHasher
+{
+public:
+    ModelHasher();
+
+    void Add(const void* data, std::size_t size);
+
+    /// Adds a value of an arithmetic or enumeration type, which has no padding
+    template<typename T>
+    void AddValue(const T& value)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "T must not contain padding");
+        Add(&value, sizeof(value));
+    }
+
+    /// Adds the elements of a vector, preceded by their number so that consecutive vectors cannot be confused
+    template<typename T>
+    void AddVector(const android::hardware::hidl_vec<T>& values)
+    {
+        AddValue(static_cast<uint64_t>(values.size()));
+        for (const T& value : values)
+        {
+            AddValue(value);
+        }
+    }
+
+    ModelHash GetHash();
+
+private:
+    SHA256_CTX m_Context;
+};
+
+/// Adds the content of a model to a hasher: its operands, operations, inputs and outputs, the values of its constant
+/// operands and the content of its memory pools. Models with the same content are converted to the same network.
+/// @return false if a memory pool of the model cannot be mapped
+template<typename HalModel>
+bool AddModelToHash(const HalModel& model, ModelHasher& hasher);
+
+/// Adds the signature of an operation of a model to a hasher: its type, the type, shape, quantization and lifetime of
+/// its operands, and the values of its constant operands of up to 256 bytes, such as its scalar
+/// parameters, axes or block shapes. Operations with the same signature are supported by the same compute devices:
+/// the values of larger constant tensors, e.g. weights, do not change whether an operation is supported.
+/// @param[in] pools the mapped memory pools of the model, in which the constant references are read
+template<typename HalModel>
+void AddOperationSignatureToHash(const HalModel& model,
+                                 uint32_t operationIndex,
+                                 const std::vector<android::nn::RunTimePoolInfo>& pools,
+                                 ModelHasher& hasher);
+
+/// Returns the digest as a hexadecimal string, e.g. to name files or in logs
+std::string ModelHashToString(const ModelHash& hash);
+
+} // namespace armnn_driver
@@ -6,6 +6,8 @@
 #define LOG_TAG "ArmnnDriver"
 
 #include "ModelToINetworkConverter.hpp"
+#include "ModelHash.hpp"
+#include "OperationSupportCache.hpp"
 
 #include <log/log.h>
 
@@ -15,10 +17,13 @@ namespace armnn_driver
 template<typename HalPolicy>
 ModelToINetworkConverter<HalPolicy>::ModelToINetworkConverter(armnn::Compute compute,
     const HalModel& model,
-    const std::set<unsigned int>& forcedUnsupportedOperations)
-    : m_Data(compute)
+    const std::set<unsigned int>& forcedUnsupportedOperations,
+    ConversionMode mode,
+    PrepareReport* report)
+    : m_Data(compute, mode)
     , m_Model(model)
     , m_ForcedUnsupportedOperations(forcedUnsupportedOperations)
+    , m_Report(report)
     , m_ConversionResult(ConversionResult::Success)
 {
     try
@@ -40,6 +45,11 @@ void ModelToINetworkConverter<HalPolicy>::Convert()
 
     ALOGV("ModelToINetworkConverter::Convert(): %s", GetModelSummary<HalModel>(m_Model).c_str());
 
+    if (m_Report)
+    {
+        m_Report->BeginPhase(PreparePhase::MapPools);
+    }
+
     // map the memory pool into shared pointers
     m_Data.m_MemPools.clear();
     if (!setRunTimePoolInfosFromHidlMemories(&m_Data.m_MemPools, m_Model.pools))
@@ -55,6 +65,11 @@ void ModelToINetworkConverter<HalPolicy>::Convert()
         totalPoolSize += pool.size();
     }
 
+    if (m_Report)
+    {
+        m_Report->BeginPhase(PreparePhase::ConvertOperations);
+    }
+
     // Create armnn::INetwork
     m_Data.m_Network = armnn::INetwork::Create();
 
@@ -103,19 +118,43 @@ void ModelToINetworkConverter<HalPolicy>::Convert()
 
         if (ok)
         {
-            try
+            const PrepareReport::Clock::time_point start = PrepareReport::Clock::now();
+
+            ModelHasher hasher;
+            AddOperationSignatureToHash(m_Model, operationIdx, m_Data.m_MemPools, hasher);
+            hasher.AddValue(m_Data.m_Compute);
+            const ModelHash signature = hasher.GetHash();
+
+            // The layers of a dry run are not used, so an operation whose signature has been converted before does not
+            // need converting again. Otherwise its layers are added to the network even if it is known to be supported.
+            OperationSupportCache& supportCache = GetOperationSupportCache();
+            bool isSupported = false;
+            if (m_Data.m_Mode == ConversionMode::DryRun && supportCache.Find(signature, isSupported))
             {
-                ok = HalPolicy::ConvertOperation(operation, m_Model, m_Data);
+                ok = isSupported;
             }
-            catch (UnsupportedOperand& e)
+            else
             {
-                Fail("%s: Operand type %s not supported in ArmnnDriver", __func__, toString(e.m_type).c_str());
-                ok = false;
+                try
+                {
+                    ok = HalPolicy::ConvertOperation(operation, m_Model, m_Data);
+                }
+                catch (UnsupportedOperand& e)
+                {
+                    Fail("%s: Operand type %s not supported in ArmnnDriver", __func__, toString(e.m_type).c_str());
+                    ok = false;
+                }
+                catch (const armnn::InvalidArgumentException& e)
+                {
+                    Fail("%s: Failed to convert operation in %s", __func__, e.what());
+                    ok = false;
+                }
+                supportCache.Insert(signature, ok);
             }
-            catch (const armnn::InvalidArgumentException& e)
+
+            if (m_Report)
             {
-                Fail("%s: Failed to convert operation in %s", __func__, e.what());
-                ok = false;
+                m_Report->AddOperation(operationIdx, toString(operation.type), PrepareReport::Clock::now() - start);
             }
         }
 
@@ -139,6 +178,12 @@ void ModelToINetworkConverter<HalPolicy>::Convert()
                 uint32_t outputIndex = m_Model.outputIndexes[i];
                 const Operand& operand = m_Model.operands[outputIndex];
                 const armnn::TensorInfo& tensor = GetTensorInfoForOperand(operand);
+
+                // The network of a dry run is not used, and some of its outputs have no output slot
+                if (m_Data.m_Mode == ConversionMode::DryRun)
+                {
+                    continue;
+                }
                 armnn::IConnectableLayer* layer = m_Data.m_Network->AddOutputLayer(i);
 
                 assert(m_Data.m_OutputSlotForOperand[outputIndex]);
@@ -151,6 +196,11 @@ void ModelToINetworkConverter<HalPolicy>::Convert()
         Fail("%s: Failed to convert output operand to TensorShape: %s", __func__, e.what());
         m_ConversionResult = ConversionResult::UnsupportedFeature;
     }
+
+    if (m_Report)
+    {
+        m_Report->EndPhase();
+    }
 }
 
 template<typename HalPolicy>
@@ -7,6 +7,7 @@
 
 #include "ArmnnDriver.hpp"
 #include "ConversionUtils.hpp"
+#include "PrepareReport.hpp"
 
 #include <armnn/ArmNN.hpp>
 
@@ -30,15 +31,24 @@ class ModelToINetworkConverter
 public:
     using HalModel = typename HalPolicy::Model;
 
+    /// @param[in] mode whether the model is converted to a network, or only checked for support in a dry run
+    /// @param[in] report if not null, records the time taken to map the memory pools and to convert each operation
     ModelToINetworkConverter(armnn::Compute compute,
                              const HalModel& model,
-                             const std::set<unsigned int>& forcedUnsupportedOperations);
+                             const std::set<unsigned int>& forcedUnsupportedOperations,
+                             ConversionMode mode = ConversionMode::Network,
+                             PrepareReport* report = nullptr);
 
     ConversionResult GetConversionResult() const { return m_ConversionResult; }
 
     // Returns the ArmNN INetwork corresponding to the input model, if preparation went smoothly, nullptr otherwise.
+    // The network of a dry run is incomplete and must not be used.
     armnn::INetwork* GetINetwork() const { return m_Data.m_Network.get(); }
 
+    // Transfers the ownership of the INetwork to the caller. The network keeps a copy of the constant tensors,
+    // so it remains valid once the converter and the memory pools of the model are released.
+    armnn::INetworkPtr TakeINetwork() { return std::move(m_Data.m_Network); }
+
     bool IsOperationSupported(uint32_t operationIndex) const;
 
 private:
@@ -50,6 +60,7 @@ private:
     // Input data
     const HalModel&               m_Model;
     const std::set<unsigned int>& m_ForcedUnsupportedOperations;
+    PrepareReport*                m_Report;
 
     // Output data
     ConversionResult         m_ConversionResult;
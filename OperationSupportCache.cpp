@@ -0,0 +1,82 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "OperationSupportCache.hpp"
+
+namespace
+{
+
+// Each entry takes about 100 bytes
+const std::size_t g_OperationSupportCacheCapacity = 4096;
+
+} // anonymous namespace
+
+namespace armnn_driver
+{
+
+OperationSupportCache::OperationSupportCache(std::size_t capacity)
+    : m_Capacity(capacity)
+    , m_NumHits(0)
+    , m_NumMisses(0)
+{
+}
+
+bool OperationSupportCache::Find(const ModelHash& signature, bool& isSupported)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Index.find(signature);
+        if (it != m_Index.end())
+        {
+            m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+            isSupported = it->second->second;
+            ++m_NumHits;
+            return true;
+        }
+    }
+
+    ++m_NumMisses;
+    return false;
+}
+
+void OperationSupportCache::Insert(const ModelHash& signature, bool isSupported)
+{
+    if (m_Capacity == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_Index.find(signature);
+    if (it != m_Index.end())
+    {
+        it->second->second = isSupported;
+        m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+        return;
+    }
+
+    if (m_Entries.size() == m_Capacity)
+    {
+        m_Index.erase(m_Entries.back().first);
+        m_Entries.pop_back();
+    }
+    m_Entries.emplace_front(signature, isSupported);
+    m_Index.emplace(signature, m_Entries.begin());
+}
+
+std::size_t OperationSupportCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Entries.size();
+}
+
+OperationSupportCache& GetOperationSupportCache()
+{
+    static OperationSupportCache operationSupportCache(g_OperationSupportCacheCapacity);
+    return operationSupportCache;
+}
+
+} // namespace armnn_driver
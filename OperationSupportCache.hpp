@@ -0,0 +1,63 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "ModelHash.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace armnn_driver
+{
+
+/// Whether the operations converted so far are supported, identified by the hash of their signature and of the compute
+/// device, see AddOperationSignatureToHash. Applications query the support of many models made of the same operations,
+/// which are then answered without converting the operations again. The least recently used entries are dropped once
+/// the capacity is reached. All the methods can be called from any thread.
+class OperationSupportCache
+{
+public:
+    explicit OperationSupportCache(std::size_t capacity);
+
+    /// Looks up the support of an operation
+    /// @return false if the signature is unknown
+    bool Find(const ModelHash& signature, bool& isSupported);
+
+    /// Records the support of an operation, dropping the least recently used entry if the cache is full
+    void Insert(const ModelHash& signature, bool isSupported);
+
+    /// Returns the number of signatures whose support is known
+    std::size_t GetSize() const;
+
+    /// Returns the number of calls to Find that found the signature
+    std::size_t GetNumHits() const { return m_NumHits.load(); }
+
+    /// Returns the number of calls to Find that did not find the signature
+    std::size_t GetNumMisses() const { return m_NumMisses.load(); }
+
+private:
+    OperationSupportCache(const OperationSupportCache&) = delete;
+    OperationSupportCache& operator=(const OperationSupportCache&) = delete;
+
+    using Entry = std::pair<ModelHash, bool>;
+
+    const std::size_t                               m_Capacity;
+    mutable std::mutex                              m_Mutex;
+    // From the most to the least recently used
+    std::list<Entry>                                m_Entries;
+    std::map<ModelHash, std::list<Entry>::iterator> m_Index;
+    std::atomic<std::size_t>                        m_NumHits;
+    std::atomic<std::size_t>                        m_NumMisses;
+};
+
+/// Returns the cache shared by all the models converted by the driver process
+OperationSupportCache& GetOperationSupportCache();
+
+} // namespace armnn_driver
@@ -0,0 +1,64 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "PendingRequestLimit.hpp"
+
+#include <boost/assert.hpp>
+
+namespace armnn_driver
+{
+
+PendingRequestLimit::PendingRequestLimit(unsigned int maxPendingRequests)
+    : m_MaxPendingRequests(maxPendingRequests)
+    , m_NumPendingRequests(0)
+    , m_NumWaiters(0)
+{
+}
+
+bool PendingRequestLimit::TryAcquire()
+{
+    unsigned int numPending = m_NumPendingRequests.load(std::memory_order_relaxed);
+    do
+    {
+        if (m_MaxPendingRequests != 0 && numPending >= m_MaxPendingRequests)
+        {
+            return false;
+        }
+    }
+    while (!m_NumPendingRequests.compare_exchange_weak(numPending, numPending + 1, std::memory_order_relaxed));
+    return true;
+}
+
+bool PendingRequestLimit::Acquire(Clock::time_point deadline)
+{
+    if (TryAcquire())
+    {
+        return true;
+    }
+
+    // Registering as a waiter before checking again, under the lock, ensures Release() does not miss us
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    ++m_NumWaiters;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const bool acquired = m_Cv.wait_until(lock, deadline, [this] { return TryAcquire(); });
+    --m_NumWaiters;
+    return acquired;
+}
+
+void PendingRequestLimit::Release()
+{
+    BOOST_ASSERT(m_NumPendingRequests.load() > 0);
+    m_NumPendingRequests.fetch_sub(1, std::memory_order_relaxed);
+
+    // Pairs with the fence in Acquire()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_NumWaiters.load(std::memory_order_relaxed) != 0)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Cv.notify_one();
+    }
+}
+
+} // namespace armnn_driver
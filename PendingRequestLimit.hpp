@@ -0,0 +1,55 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace armnn_driver
+{
+
+/// Bounds the number of requests submitted and not completed yet, so that a burst of requests cannot grow
+/// the memory held by the queued requests, and their latency, without limit.
+/// Admitting and completing a request is lock-free, unless a client is waiting for a request to complete.
+class PendingRequestLimit
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @param[in] maxPendingRequests the maximum number of pending requests, 0 for no limit
+    PendingRequestLimit(unsigned int maxPendingRequests);
+
+    /// Admits a request if the limit has not been reached, otherwise waits for a pending request to complete.
+    /// Can be called from any thread.
+    /// @param[in] deadline the time until which to wait, a time in the past to fail immediately
+    /// @return false if the limit was still reached at the deadline, in which case the request is not admitted
+    bool Acquire(Clock::time_point deadline);
+
+    /// Completes a request admitted by Acquire. Can be called from any thread.
+    void Release();
+
+    /// Returns the number of requests admitted and not completed yet
+    unsigned int GetNumPendingRequests() const { return m_NumPendingRequests.load(std::memory_order_relaxed); }
+
+    /// Returns the maximum number of pending requests, 0 for no limit
+    unsigned int GetMaxPendingRequests() const { return m_MaxPendingRequests; }
+
+private:
+    PendingRequestLimit(const PendingRequestLimit&) = delete;
+    PendingRequestLimit& operator=(const PendingRequestLimit&) = delete;
+
+    bool TryAcquire();
+
+    const unsigned int        m_MaxPendingRequests;
+    std::atomic<unsigned int> m_NumPendingRequests;
+    std::atomic<unsigned int> m_NumWaiters;
+    std::mutex                m_Mutex;
+    std::condition_variable   m_Cv;
+};
+
+} // namespace armnn_driver
@@ -0,0 +1,85 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "PreparationPool.hpp"
+
+#include <log/log.h>
+
+namespace armnn_driver
+{
+
+PreparationPool::PreparationPool(unsigned int numThreads, unsigned int maxQueuedTasks)
+    : m_MaxQueuedTasks(maxQueuedTasks)
+    , m_Exit(false)
+{
+    ALOGV("PreparationPool::PreparationPool(): %u threads", numThreads);
+
+    m_Threads.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        m_Threads.emplace_back(&PreparationPool::Process, this);
+    }
+}
+
+PreparationPool::~PreparationPool()
+{
+    ALOGV("PreparationPool::~PreparationPool()");
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Exit = true;
+    }
+    m_Cv.notify_all();
+
+    for (std::thread& thread : m_Threads)
+    {
+        thread.join();
+    }
+}
+
+void PreparationPool::Post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Threads.empty() && (m_MaxQueuedTasks == 0 || m_Tasks.size() < m_MaxQueuedTasks))
+        {
+            m_Tasks.push_back(std::move(task));
+            m_Cv.notify_one();
+            return;
+        }
+    }
+
+    if (!m_Threads.empty())
+    {
+        ALOGW("PreparationPool::Post: %u preparations are already queued, preparing in the calling thread",
+              m_MaxQueuedTasks);
+    }
+    task();
+}
+
+void PreparationPool::Process()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (true)
+    {
+        m_Cv.wait(lock, [this] { return m_Exit || !m_Tasks.empty(); });
+        // Queued preparations are completed before exiting, so that every client is notified
+        if (m_Tasks.empty())
+        {
+            return;
+        }
+
+        Task task = std::move(m_Tasks.front());
+        m_Tasks.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+} // namespace armnn_driver
@@ -0,0 +1,55 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// Worker threads preparing models in the background, so that prepareModel returns to the client as soon as the
+/// model is validated, and several models can be prepared in parallel. The client is notified through its callback.
+class PreparationPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /// Constructor creates the worker threads
+    /// @param[in] numThreads the number of worker threads, 0 to prepare the models in the threads calling Post
+    /// @param[in] maxQueuedTasks the maximum number of preparations waiting for a worker, 0 for no limit. Beyond it,
+    ///            the thread calling Post prepares the model itself, which slows down the clients preparing too many
+    ///            models at once.
+    PreparationPool(unsigned int numThreads, unsigned int maxQueuedTasks);
+
+    /// Destructor completes the queued preparations, then terminates the worker threads
+    ~PreparationPool();
+
+    /// Runs a task on a worker thread, or in the calling thread if there is no worker or the queue is full
+    void Post(Task task);
+
+    /// Returns the number of worker threads
+    unsigned int GetNumThreads() const { return static_cast<unsigned int>(m_Threads.size()); }
+
+private:
+    PreparationPool(const PreparationPool&) = delete;
+    PreparationPool& operator=(const PreparationPool&) = delete;
+
+    void Process();
+
+    const unsigned int       m_MaxQueuedTasks;
+    std::vector<std::thread> m_Threads;
+    std::mutex               m_Mutex;
+    std::condition_variable  m_Cv;
+    std::deque<Task>         m_Tasks;
+    bool                     m_Exit;
+};
+
+} // namespace armnn_driver
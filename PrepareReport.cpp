@@ -0,0 +1,203 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "PrepareReport.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/format.hpp>
+#include <log/log.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace armnn_driver;
+
+const char* g_PhaseNames[] =
+{
+    "map_pools",
+    "convert_operations",
+    "optimize",
+    "load_network",
+    "load_batched_network",
+    "warm_up",
+    "save_tuned_parameters"
+};
+
+static_assert(sizeof(g_PhaseNames) / sizeof(g_PhaseNames[0]) == static_cast<unsigned int>(PreparePhase::NumPhases),
+              "A name is required for each prepare phase");
+
+} // anonymous namespace
+
+namespace armnn_driver
+{
+
+int64_t GetResidentSetSizeKb()
+{
+    // The second field of statm is the number of resident pages
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+    {
+        return 0;
+    }
+    long long sizePages = 0;
+    long long residentPages = 0;
+    const int numRead = fscanf(file, "%lld %lld", &sizePages, &residentPages);
+    fclose(file);
+    return numRead == 2 ? residentPages * (sysconf(_SC_PAGESIZE) / 1024) : 0;
+}
+
+int64_t GetPeakResidentSetSizeKb()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    // In KB on Linux
+    return usage.ru_maxrss;
+}
+
+PrepareReport::PrepareReport()
+    : m_Start(Clock::now())
+    , m_CurrentPhase(NumPhases)
+    , m_PhaseStartRssKb(0)
+    , m_PhaseStartPeakRssKb(0)
+{
+    m_Phases.fill({ false, std::chrono::microseconds(0), 0, 0 });
+}
+
+void PrepareReport::BeginPhase(PreparePhase phase)
+{
+    EndPhase();
+
+    m_CurrentPhase = static_cast<unsigned int>(phase);
+    BOOST_ASSERT(m_CurrentPhase < NumPhases);
+
+    m_PhaseStartRssKb     = GetResidentSetSizeKb();
+    m_PhaseStartPeakRssKb = GetPeakResidentSetSizeKb();
+    m_PhaseStart          = Clock::now();
+}
+
+void PrepareReport::EndPhase()
+{
+    if (m_CurrentPhase == NumPhases)
+    {
+        return;
+    }
+
+    Phase& phase = m_Phases[m_CurrentPhase];
+    phase.m_Ran             = true;
+    phase.m_Duration       += std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_PhaseStart);
+    phase.m_RssDeltaKb     += GetResidentSetSizeKb() - m_PhaseStartRssKb;
+    phase.m_PeakRssDeltaKb += GetPeakResidentSetSizeKb() - m_PhaseStartPeakRssKb;
+
+    m_CurrentPhase = NumPhases;
+}
+
+void PrepareReport::AddOperation(uint32_t index, const std::string& type, Clock::duration duration)
+{
+    m_Operations.push_back({ index, type, std::chrono::duration_cast<std::chrono::microseconds>(duration) });
+}
+
+std::chrono::microseconds PrepareReport::GetDuration(PreparePhase phase) const
+{
+    const unsigned int index = static_cast<unsigned int>(phase);
+    BOOST_ASSERT(index < NumPhases);
+    return m_Phases[index].m_Duration;
+}
+
+std::chrono::microseconds PrepareReport::GetTotalDuration() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_Start);
+}
+
+std::string PrepareReport::GetSummary() const
+{
+    std::stringstream summary;
+    summary << "total " << GetTotalDuration().count() / 1000 << " ms";
+
+    int64_t peakRssDeltaKb = 0;
+    for (unsigned int i = 0; i < NumPhases; ++i)
+    {
+        const Phase& phase = m_Phases[i];
+        if (phase.m_Ran)
+        {
+            summary << ", " << g_PhaseNames[i] << " " << phase.m_Duration.count() / 1000 << " ms";
+            peakRssDeltaKb += phase.m_PeakRssDeltaKb;
+        }
+    }
+    summary << ", " << m_Operations.size() << " operations, peak RSS +" << peakRssDeltaKb << " KB";
+    return summary.str();
+}
+
+void PrepareReport::DumpJson(const std::string& dumpDir, armnn::NetworkId networkId) const
+{
+    // The dump directory must exist in advance.
+    if (dumpDir.empty())
+    {
+        return;
+    }
+
+    const std::string fileName = boost::str(boost::format("%1%/%2%_prepare.json")
+                                            % dumpDir
+                                            % std::to_string(networkId));
+
+    std::ofstream fileStream;
+    fileStream.open(fileName, std::ofstream::out | std::ofstream::trunc);
+
+    if (!fileStream.good())
+    {
+        ALOGW("Could not open file %s for writing", fileName.c_str());
+        return;
+    }
+
+    fileStream << "{\n";
+    fileStream << "  \"network_id\": " << networkId << ",\n";
+    fileStream << "  \"total_us\": " << GetTotalDuration().count() << ",\n";
+    fileStream << "  \"rss_kb\": " << GetResidentSetSizeKb() << ",\n";
+    fileStream << "  \"peak_rss_kb\": " << GetPeakResidentSetSizeKb() << ",\n";
+    fileStream << "  \"phases\": [";
+    const char* separator = "\n";
+    for (unsigned int i = 0; i < NumPhases; ++i)
+    {
+        const Phase& phase = m_Phases[i];
+        if (!phase.m_Ran)
+        {
+            continue;
+        }
+        fileStream << separator
+                   << "    { \"name\": \"" << g_PhaseNames[i] << "\""
+                   << ", \"duration_us\": " << phase.m_Duration.count()
+                   << ", \"rss_delta_kb\": " << phase.m_RssDeltaKb
+                   << ", \"peak_rss_delta_kb\": " << phase.m_PeakRssDeltaKb
+                   << " }";
+        separator = ",\n";
+    }
+    fileStream << "\n  ],\n";
+    fileStream << "  \"operations\": [";
+    separator = "\n";
+    for (const Operation& operation : m_Operations)
+    {
+        fileStream << separator
+                   << "    { \"index\": " << operation.m_Index
+                   << ", \"type\": \"" << operation.m_Type << "\""
+                   << ", \"duration_us\": " << operation.m_Duration.count()
+                   << " }";
+        separator = ",\n";
+    }
+    fileStream << "\n  ]\n";
+    fileStream << "}\n";
+}
+
+} // namespace armnn_driver
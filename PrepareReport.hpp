@@ -0,0 +1,98 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <armnn/ArmNN.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// The phases of the preparation of a model, in the order they run
+enum class PreparePhase : unsigned int
+{
+    MapPools,               // the memory pools of the model are mapped by ModelToINetworkConverter
+    ConvertOperations,      // the operations are converted to layers, each one is also timed separately
+    Optimize,               // armnn::Optimize
+    LoadNetwork,            // the optimized network is loaded in the runtime
+    LoadBatchedNetwork,     // the variant of the network executing batches is converted, optimized and loaded
+    WarmUp,                 // the inference on dummy inputs, unless it is deferred or disabled
+    SaveTunedParameters,    // the CL tuned parameters are saved, when they are updated
+    NumPhases
+};
+
+/// Records how long each phase of the preparation of a model takes, and how the resident memory of the driver
+/// grows during it. The memory is measured for the whole process, so it includes the models prepared concurrently.
+class PrepareReport
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    PrepareReport();
+
+    /// Starts timing a phase, which ends when the next one begins or EndPhase is called
+    void BeginPhase(PreparePhase phase);
+
+    void EndPhase();
+
+    /// Records the time taken to convert an operation of the model
+    void AddOperation(uint32_t index, const std::string& type, Clock::duration duration);
+
+    /// Returns the duration of a phase, zero if it did not run
+    std::chrono::microseconds GetDuration(PreparePhase phase) const;
+
+    /// Returns the time elapsed since the report was created
+    std::chrono::microseconds GetTotalDuration() const;
+
+    /// Returns the duration and memory growth of each phase that ran, on one line
+    std::string GetSummary() const;
+
+    /// Writes the phases and the conversion time of each operation to <dumpDir>/<networkId>_prepare.json.
+    /// Does nothing if the dump directory is empty.
+    void DumpJson(const std::string& dumpDir, armnn::NetworkId networkId) const;
+
+private:
+    struct Phase
+    {
+        bool                      m_Ran;
+        std::chrono::microseconds m_Duration;
+        // The growth of the resident set size, and of its peak since the driver started
+        int64_t                   m_RssDeltaKb;
+        int64_t                   m_PeakRssDeltaKb;
+    };
+
+    struct Operation
+    {
+        uint32_t                  m_Index;
+        std::string               m_Type;
+        std::chrono::microseconds m_Duration;
+    };
+
+    static const unsigned int NumPhases = static_cast<unsigned int>(PreparePhase::NumPhases);
+
+    const Clock::time_point      m_Start;
+    std::array<Phase, NumPhases> m_Phases;
+    std::vector<Operation>       m_Operations;
+
+    // The phase being timed, NumPhases if none, and the time and memory usage when it began
+    unsigned int      m_CurrentPhase;
+    Clock::time_point m_PhaseStart;
+    int64_t           m_PhaseStartRssKb;
+    int64_t           m_PhaseStartPeakRssKb;
+};
+
+/// Returns the resident set size of the driver process in KB, or 0 if it cannot be read
+int64_t GetResidentSetSizeKb();
+
+/// Returns the peak resident set size of the driver process since it started in KB
+int64_t GetPeakResidentSetSizeKb();
+
+} // namespace armnn_driver
@@ -0,0 +1,156 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "PreparedNetworkCache.hpp"
+#include "Utils.hpp"
+
+#include <log/log.h>
+
+#include <chrono>
+
+namespace armnn_driver
+{
+
+SharedNetwork::SharedNetwork(armnn::IRuntime* runtime,
+                             armnn::NetworkId networkId,
+                             const BatchedNetwork& batchedNetwork,
+                             LoadedNetworkBudget& budget,
+                             std::size_t size,
+                             const Loader& loader)
+    : m_Runtime(runtime)
+    , m_NetworkId(networkId)
+    , m_BatchedNetwork(batchedNetwork)
+    , m_Budget(budget)
+    , m_Size(size)
+    , m_Loader(loader)
+    , m_IsLoaded(true)
+{
+    m_Budget.Add(*this);
+}
+
+SharedNetwork::~SharedNetwork()
+{
+    // Once removed from the budget the network cannot be evicted concurrently
+    m_Budget.Remove(*this);
+    if (m_IsLoaded.load())
+    {
+        Unload();
+    }
+}
+
+bool SharedNetwork::Load()
+{
+    if (m_IsLoaded.load())
+    {
+        m_Budget.Touch(*this);
+        return true;
+    }
+
+    if (!m_Loader)
+    {
+        return false;
+    }
+
+    const LoadedNetworkBudget::Clock::time_point start = LoadedNetworkBudget::Clock::now();
+    armnn::NetworkId networkId = 0;
+    BatchedNetwork batchedNetwork;
+    if (!m_Loader(networkId, batchedNetwork))
+    {
+        ALOGE("SharedNetwork: could not load the network again");
+        return false;
+    }
+    const LoadedNetworkBudget::Clock::duration duration = LoadedNetworkBudget::Clock::now() - start;
+
+    ALOGI("SharedNetwork: loaded network %d again as network %d in %lld ms", m_NetworkId, networkId,
+          static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()));
+    m_NetworkId      = networkId;
+    m_BatchedNetwork = batchedNetwork;
+    m_IsLoaded.store(true);
+    m_Budget.RecordReload(duration);
+    m_Budget.Add(*this);
+    return true;
+}
+
+bool SharedNetwork::TryEvict()
+{
+    std::unique_lock<std::mutex> executionLock(m_ExecutionMutex, std::try_to_lock);
+    if (!executionLock.owns_lock() || !m_IsLoaded.load())
+    {
+        return false;
+    }
+
+    Unload();
+    m_IsLoaded.store(false);
+    return true;
+}
+
+void SharedNetwork::Unload()
+{
+    std::lock_guard<std::mutex> loadingLock(GetNetworkLoadingMutex());
+    m_Runtime->UnloadNetwork(m_NetworkId);
+    if (m_BatchedNetwork.IsValid())
+    {
+        m_Runtime->UnloadNetwork(m_BatchedNetwork.m_NetworkId);
+    }
+}
+
+PreparedNetworkCache::PreparedNetworkCache()
+    : m_NumHits(0)
+    , m_NumMisses(0)
+{
+}
+
+std::shared_ptr<SharedNetwork> PreparedNetworkCache::Find(const ModelHash& hash)
+{
+    std::shared_ptr<SharedNetwork> network;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Networks.find(hash);
+        if (it != m_Networks.end())
+        {
+            network = it->second.lock();
+        }
+    }
+
+    if (network)
+    {
+        ++m_NumHits;
+        ALOGV("PreparedNetworkCache: reusing the network of model %s", ModelHashToString(hash).c_str());
+    }
+    else
+    {
+        ++m_NumMisses;
+    }
+    return network;
+}
+
+void PreparedNetworkCache::Insert(const ModelHash& hash, const std::shared_ptr<SharedNetwork>& network)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Forget the networks unloaded since, so that the cache does not grow with every model ever prepared
+    for (auto it = m_Networks.begin(); it != m_Networks.end();)
+    {
+        it = it->second.expired() ? m_Networks.erase(it) : std::next(it);
+    }
+
+    m_Networks[hash] = network;
+}
+
+std::size_t PreparedNetworkCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    std::size_t size = 0;
+    for (const auto& entry : m_Networks)
+    {
+        size += entry.second.expired() ? 0 : 1;
+    }
+    return size;
+}
+
+} // namespace armnn_driver
@@ -0,0 +1,123 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "LoadedNetworkBudget.hpp"
+#include "ModelHash.hpp"
+#include "RequestBatching.hpp"
+
+#include <armnn/ArmNN.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace armnn_driver
+{
+
+/// A network loaded in the runtime, with its batched variant if any, shared by the prepared models of identical
+/// models. The networks are unloaded when the last prepared model using them is released, or earlier to fit the
+/// budget of the loaded networks, in which case they are loaded again by the next execution.
+class SharedNetwork
+{
+public:
+    /// Loads the network again after it was unloaded to fit the budget, returning its new ids
+    using Loader = std::function<bool(armnn::NetworkId& networkId, BatchedNetwork& batchedNetwork)>;
+
+    /// @param[in] size the estimated memory used by the network, counted against the budget
+    /// @param[in] loader loads the network again, may be empty if the budget is disabled
+    SharedNetwork(armnn::IRuntime* runtime,
+                  armnn::NetworkId networkId,
+                  const BatchedNetwork& batchedNetwork,
+                  LoadedNetworkBudget& budget,
+                  std::size_t size,
+                  const Loader& loader);
+    ~SharedNetwork();
+
+    armnn::IRuntime* GetRuntime() const { return m_Runtime; }
+
+    /// Returns the ids of the network and of its batched variant, which change when the network is loaded again.
+    /// Must be called with the execution mutex held, after Load.
+    armnn::NetworkId GetNetworkId() const { return m_NetworkId; }
+    const BatchedNetwork& GetBatchedNetwork() const { return m_BatchedNetwork; }
+
+    /// Returns the mutex serialising the executions of the network by the prepared models sharing it,
+    /// as the runtime does not support executing a network on several threads at once
+    std::mutex& GetExecutionMutex() { return m_ExecutionMutex; }
+
+    /// Loads the network again if it was unloaded, and marks it as the most recently used.
+    /// Must be called with the execution mutex held, before executing the network.
+    /// @return false if the network could not be loaded again
+    bool Load();
+
+    /// Unloads the network to fit the budget, unless it is executing. Called by LoadedNetworkBudget.
+    /// @return false if the network is executing or already unloaded
+    bool TryEvict();
+
+    /// Returns whether the network is loaded in the runtime
+    bool IsLoaded() const { return m_IsLoaded.load(); }
+
+    /// Returns the estimated memory in bytes used by the network
+    std::size_t GetSize() const { return m_Size; }
+
+    /// Returns the budget the network is counted against
+    const LoadedNetworkBudget& GetBudget() const { return m_Budget; }
+
+private:
+    SharedNetwork(const SharedNetwork&) = delete;
+    SharedNetwork& operator=(const SharedNetwork&) = delete;
+
+    /// Unloads the network and its batched variant from the runtime
+    void Unload();
+
+    armnn::IRuntime* const m_Runtime;
+    armnn::NetworkId       m_NetworkId;
+    BatchedNetwork         m_BatchedNetwork;
+    LoadedNetworkBudget&   m_Budget;
+    const std::size_t      m_Size;
+    const Loader           m_Loader;
+    std::atomic<bool>      m_IsLoaded;
+    std::mutex             m_ExecutionMutex;
+};
+
+/// The networks loaded for the models prepared so far, identified by the hash of the model and of the options
+/// they were prepared with, so that preparing a model again reuses its network rather than converting, optimizing
+/// and loading it again. The cache does not keep the networks alive: they are unloaded as soon as no prepared
+/// model uses them. All the methods can be called from any thread.
+class PreparedNetworkCache
+{
+public:
+    PreparedNetworkCache();
+
+    /// Returns the network loaded for the given hash, nullptr if there is none
+    std::shared_ptr<SharedNetwork> Find(const ModelHash& hash);
+
+    /// Records the network loaded for the given hash, replacing any previous one
+    void Insert(const ModelHash& hash, const std::shared_ptr<SharedNetwork>& network);
+
+    /// Returns the number of networks in use that the cache refers to
+    std::size_t GetSize() const;
+
+    /// Returns the number of calls to Find that returned a network, for testing
+    std::size_t GetNumHits() const { return m_NumHits.load(); }
+
+    /// Returns the number of calls to Find that returned nullptr, for testing
+    std::size_t GetNumMisses() const { return m_NumMisses.load(); }
+
+private:
+    PreparedNetworkCache(const PreparedNetworkCache&) = delete;
+    PreparedNetworkCache& operator=(const PreparedNetworkCache&) = delete;
+
+    mutable std::mutex                                m_Mutex;
+    std::map<ModelHash, std::weak_ptr<SharedNetwork>> m_Networks;
+    std::atomic<std::size_t>                          m_NumHits;
+    std::atomic<std::size_t>                          m_NumMisses;
+};
+
+} // namespace armnn_driver
@@ -0,0 +1,178 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "RequestBatching.hpp"
+
+#include <log/log.h>
+
+#include <cstring>
+
+namespace V1_0 = ::android::hardware::neuralnetworks::V1_0;
+
+namespace armnn_driver
+{
+
+namespace
+{
+
+/// Returns true for the operations that treat each element of the batch dimension (dimension 0) independently
+template<typename OperationType>
+bool IsBatchAgnosticOperationType(OperationType type)
+{
+    switch (type)
+    {
+        case OperationType::ADD:
+        case OperationType::AVERAGE_POOL_2D:
+        case OperationType::CONCATENATION:
+        case OperationType::CONV_2D:
+        case OperationType::DEPTHWISE_CONV_2D:
+        case OperationType::FLOOR:
+        case OperationType::FULLY_CONNECTED:
+        case OperationType::L2_NORMALIZATION:
+        case OperationType::L2_POOL_2D:
+        case OperationType::LOCAL_RESPONSE_NORMALIZATION:
+        case OperationType::LOGISTIC:
+        case OperationType::MAX_POOL_2D:
+        case OperationType::MUL:
+        case OperationType::RELU:
+        case OperationType::RELU1:
+        case OperationType::RELU6:
+        case OperationType::RESIZE_BILINEAR:
+        case OperationType::SOFTMAX:
+        case OperationType::TANH:
+            return true;
+        default:
+            return false;
+    }
+}
+
+#ifdef ARMNN_ANDROID_NN_V1_1
+bool IsBatchAgnosticOperationType(V1_1::OperationType type)
+{
+    switch (type)
+    {
+        case V1_1::OperationType::DIV:
+        case V1_1::OperationType::SUB:
+            return true;
+        default:
+            return IsBatchAgnosticOperationType<V1_1::OperationType>(type);
+    }
+}
+#endif
+
+bool IsTensorOperand(const Operand& operand)
+{
+    return operand.type == OperandType::TENSOR_FLOAT32 ||
+           operand.type == OperandType::TENSOR_INT32 ||
+           operand.type == OperandType::TENSOR_QUANT8_ASYMM;
+}
+
+bool IsConstantOperand(const Operand& operand)
+{
+    return operand.lifetime == OperandLifeTime::CONSTANT_COPY ||
+           operand.lifetime == OperandLifeTime::CONSTANT_REFERENCE ||
+           operand.lifetime == OperandLifeTime::NO_VALUE;
+}
+
+template<typename HalModel, typename HalOperation>
+bool IsBatchAgnosticOperation(const HalModel& model, const HalOperation& operation)
+{
+    if (!IsBatchAgnosticOperationType(operation.type))
+    {
+        return false;
+    }
+
+    if (operation.type == decltype(operation.type)::CONCATENATION)
+    {
+        // The concatenation axis is the last input, and must not be the batch dimension
+        const Operand& axis = model.operands[operation.inputs[operation.inputs.size() - 1]];
+        if (axis.lifetime != OperandLifeTime::CONSTANT_COPY || axis.location.length != sizeof(int32_t))
+        {
+            return false;
+        }
+        int32_t axisValue = 0;
+        std::memcpy(&axisValue, &model.operandValues[axis.location.offset], sizeof(axisValue));
+        return axisValue != 0;
+    }
+
+    if (operation.type == decltype(operation.type)::FULLY_CONNECTED)
+    {
+        // The input is flattened to [batch, inputSize], which only keeps the batch dimension
+        // when the remaining dimensions match the input size of the weights
+        const Operand& input   = model.operands[operation.inputs[0]];
+        const Operand& weights = model.operands[operation.inputs[1]];
+        if (weights.dimensions.size() != 2)
+        {
+            return false;
+        }
+        uint32_t inputSize = 1;
+        for (size_t i = 1; i < input.dimensions.size(); ++i)
+        {
+            inputSize *= input.dimensions[i];
+        }
+        return inputSize == weights.dimensions[1];
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+template<typename HalModel>
+bool IsModelBatchable(const HalModel& model)
+{
+    for (const Operand& operand : model.operands)
+    {
+        if (IsConstantOperand(operand))
+        {
+            continue;
+        }
+        if (!IsTensorOperand(operand) || operand.dimensions.size() == 0 || operand.dimensions[0] != 1)
+        {
+            return false;
+        }
+    }
+
+    for (const auto& operation : model.operations)
+    {
+        if (!IsBatchAgnosticOperation(model, operation))
+        {
+            ALOGV("IsModelBatchable: operation %s does not support batching", toString(operation.type).c_str());
+            return false;
+        }
+    }
+
+    return model.inputIndexes.size() > 0 && model.outputIndexes.size() > 0;
+}
+
+template<typename HalModel>
+HalModel CreateBatchedModel(const HalModel& model, unsigned int batchSize)
+{
+    HalModel batchedModel = model;
+    for (Operand& operand : batchedModel.operands)
+    {
+        if (!IsConstantOperand(operand) && operand.dimensions.size() > 0)
+        {
+            operand.dimensions[0] = batchSize;
+        }
+    }
+    return batchedModel;
+}
+
+///
+/// Class template specializations
+///
+
+template bool IsModelBatchable<V1_0::Model>(const V1_0::Model& model);
+template V1_0::Model CreateBatchedModel<V1_0::Model>(const V1_0::Model& model, unsigned int batchSize);
+
+#ifdef ARMNN_ANDROID_NN_V1_1
+template bool IsModelBatchable<V1_1::Model>(const V1_1::Model& model);
+template V1_1::Model CreateBatchedModel<V1_1::Model>(const V1_1::Model& model, unsigned int batchSize);
+#endif
+
+} // namespace armnn_driver
@@ -0,0 +1,46 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <HalInterfaces.h>
+#include <armnn/ArmNN.hpp>
+
+#include <chrono>
+
+namespace armnn_driver
+{
+
+/// A variant of a prepared network that executes several requests at once, stacked along the batch dimension
+struct BatchedNetwork
+{
+    BatchedNetwork()
+        : m_NetworkId(0)
+        , m_BatchSize(1)
+        , m_MaxWait(0)
+    {
+    }
+
+    bool IsValid() const { return m_BatchSize > 1; }
+
+    armnn::NetworkId          m_NetworkId;
+    /// The number of requests executed by the batched network, 1 when there is no batched network
+    unsigned int              m_BatchSize;
+    /// How long the request thread waits for more requests to fill a batch
+    std::chrono::microseconds m_MaxWait;
+};
+
+/// Checks whether the requests for a model can be executed together by stacking them along the batch dimension.
+/// This is the case when all the inputs, outputs and intermediate tensors have a batch size of one, and every
+/// operation computes each element of the batch independently of the others.
+template<typename HalModel>
+bool IsModelBatchable(const HalModel& model);
+
+/// Creates a copy of a batchable model where the batch dimension of the inputs, outputs and intermediate tensors
+/// is set to the given batch size
+template<typename HalModel>
+HalModel CreateBatchedModel(const HalModel& model, unsigned int batchSize);
+
+} // namespace armnn_driver
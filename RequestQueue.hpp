@@ -0,0 +1,206 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace armnn_driver
+{
+
+/// A bounded, lock-free, multi-producer/single-consumer FIFO queue.
+/// Producers never take a lock unless the consumer is parked waiting for work. The consumer spins briefly
+/// when the queue is empty before parking on a condition variable, so that back-to-back requests are
+/// picked up without a context switch.
+template<typename T>
+class RequestQueue
+{
+public:
+    /// @param[in] capacity the maximum number of items in the queue, rounded up to a power of two
+    /// @param[in] spinCount the number of times the consumer polls an empty queue before parking
+    RequestQueue(std::size_t capacity, unsigned int spinCount = 1000)
+        : m_Mask(RoundUpToPowerOfTwo(capacity) - 1)
+        , m_Buffer(new Cell[m_Mask + 1])
+        , m_SpinCount(spinCount)
+        , m_EnqueuePos(0)
+        , m_DequeuePos(0)
+        , m_ConsumerParked(false)
+    {
+        for (std::size_t i = 0; i <= m_Mask; ++i)
+        {
+            m_Buffer[i].m_Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RequestQueue(const RequestQueue&) = delete;
+    RequestQueue& operator=(const RequestQueue&) = delete;
+
+    std::size_t GetCapacity() const { return m_Mask + 1; }
+
+    /// Adds an item to the queue, if it is not full. Can be called from any thread.
+    /// @return false if the queue is full, in which case the item is left untouched
+    bool TryPush(T& item)
+    {
+        Cell* cell = nullptr;
+        std::size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &m_Buffer[pos & m_Mask];
+            const std::size_t sequence = cell->m_Sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // The cell is free, try to claim it
+                if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The cell still holds an item from the previous lap, so the queue is full
+                return false;
+            }
+            else
+            {
+                // Another producer claimed the cell first
+                pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->m_Item = std::move(item);
+        cell->m_Sequence.store(pos + 1, std::memory_order_release);
+
+        // Pairs with the fence in Pop(): either the consumer sees the new item before parking,
+        // or we see that it has parked and wake it up
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_ConsumerParked.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Cv.notify_one();
+        }
+        return true;
+    }
+
+    /// Adds an item to the queue, yielding until there is space for it. Can be called from any thread.
+    void Push(T& item)
+    {
+        while (!TryPush(item))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /// Removes the item at the front of the queue, if there is one. Must only be called by the consumer thread.
+    /// @return false if the queue is empty
+    bool TryPop(T& item)
+    {
+        const std::size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+        Cell& cell = m_Buffer[pos & m_Mask];
+        const std::size_t sequence = cell.m_Sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0)
+        {
+            return false;
+        }
+
+        m_DequeuePos.store(pos + 1, std::memory_order_relaxed);
+        item = std::move(cell.m_Item);
+        // Release the cell for the producers' next lap around the buffer
+        cell.m_Sequence.store(pos + m_Mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Removes the item at the front of the queue, waiting for one if the queue is empty.
+    /// Must only be called by the consumer thread.
+    void Pop(T& item)
+    {
+        for (unsigned int i = 0; i < m_SpinCount; ++i)
+        {
+            if (TryPop(item))
+            {
+                return;
+            }
+        }
+
+        m_ConsumerParked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (!TryPop(item))
+        {
+            m_Cv.wait(lock);
+        }
+        m_ConsumerParked.store(false, std::memory_order_relaxed);
+    }
+
+    /// Removes the item at the front of the queue, waiting until the given time if the queue is empty.
+    /// Must only be called by the consumer thread.
+    /// @return false if the queue was still empty at the given time
+    bool PopUntil(T& item, std::chrono::steady_clock::time_point deadline)
+    {
+        for (unsigned int i = 0; i < m_SpinCount; ++i)
+        {
+            if (TryPop(item))
+            {
+                return true;
+            }
+        }
+
+        m_ConsumerParked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        bool popped = TryPop(item);
+        while (!popped && m_Cv.wait_until(lock, deadline) != std::cv_status::timeout)
+        {
+            popped = TryPop(item);
+        }
+        // An item may have been pushed right before the deadline
+        popped = popped || TryPop(item);
+        m_ConsumerParked.store(false, std::memory_order_relaxed);
+        return popped;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> m_Sequence;
+        T                        m_Item;
+    };
+
+    static std::size_t RoundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const std::size_t       m_Mask;
+    std::unique_ptr<Cell[]> m_Buffer;
+    const unsigned int      m_SpinCount;
+
+    // Keep the producer and consumer positions on separate cache lines to avoid false sharing
+    char                     m_Padding0[64];
+    std::atomic<std::size_t> m_EnqueuePos;
+    char                     m_Padding1[64];
+    std::atomic<std::size_t> m_DequeuePos;
+    char                     m_Padding2[64];
+
+    std::atomic<bool>       m_ConsumerParked;
+    std::mutex              m_Mutex;
+    std::condition_variable m_Cv;
+};
+
+} // namespace armnn_driver
@@ -0,0 +1,81 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "RequestSlotPool.hpp"
+
+#include <boost/assert.hpp>
+
+#include <log/log.h>
+
+namespace armnn_driver
+{
+
+RequestSlotPool::RequestSlotPool()
+    : m_NumGrowths(0)
+{
+}
+
+RequestSlot* RequestSlotPool::Acquire(std::size_t numPools, std::size_t numInputs, std::size_t numOutputs)
+{
+    RequestSlot* slot = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_FreeSlots.empty())
+        {
+            m_Slots.emplace_back(std::make_unique<RequestSlot>());
+            slot = m_Slots.back().get();
+            // Make room for the slot to be released, so that Release never allocates
+            m_FreeSlots.reserve(m_Slots.size());
+            ++m_NumGrowths;
+            ALOGV("RequestSlotPool::Acquire(): created slot %zu", m_Slots.size());
+        }
+        else
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+    }
+
+    Reserve(slot->m_MemPools, numPools);
+    Reserve(slot->m_InputTensors, numInputs);
+    Reserve(slot->m_OutputTensors, numOutputs);
+    Reserve(slot->m_OutputPoolIndexes, numOutputs);
+    return slot;
+}
+
+void RequestSlotPool::Release(RequestSlot* slot)
+{
+    BOOST_ASSERT(slot != nullptr);
+
+    // clear() keeps the capacity of the vectors for the next request
+    slot->m_MemPools.clear();
+    slot->m_InputTensors.clear();
+    slot->m_OutputTensors.clear();
+    slot->m_OutputPoolIndexes.clear();
+    slot->m_Callback.clear();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_FreeSlots.push_back(slot);
+}
+
+std::size_t RequestSlotPool::GetNumSlots() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Slots.size();
+}
+
+template <typename Container>
+void RequestSlotPool::Reserve(Container& container, std::size_t size)
+{
+    if (container.capacity() < size)
+    {
+        container.reserve(size);
+        ++m_NumGrowths;
+    }
+}
+
+} // namespace armnn_driver
@@ -0,0 +1,73 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "RequestTimings.hpp"
+
+#include <HalInterfaces.h>
+#include <CpuExecutor.h>
+#include <armnn/ArmNN.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace armnn_driver
+{
+
+/// The state of a request between its submission in execute and its completion on the request thread
+struct RequestSlot
+{
+    std::vector<std::shared_ptr<::android::nn::RunTimePoolInfo>> m_MemPools;
+    armnn::InputTensors                                           m_InputTensors;
+    armnn::OutputTensors                                          m_OutputTensors;
+    // The pools written by the outputs of the request, which are committed after execution
+    std::vector<uint32_t>                                         m_OutputPoolIndexes;
+    ::android::sp<IExecutionCallback>                             m_Callback;
+    // The index of the request among those received by the prepared model, which names its dumped tensors
+    uint32_t                                                      m_RequestIndex = 0;
+    RequestTimings                                                m_Timings;
+};
+
+/// A pool of request slots owned by a prepared model.
+/// Released slots keep the capacity of their containers, so once the pool has warmed up
+/// acquiring and releasing a slot does not allocate any memory.
+class RequestSlotPool
+{
+public:
+    RequestSlotPool();
+
+    /// Returns a free slot, creating a new one if all the slots are in use.
+    /// The containers of the slot are reserved for the given number of elements.
+    /// Can be called from any thread.
+    RequestSlot* Acquire(std::size_t numPools, std::size_t numInputs, std::size_t numOutputs);
+
+    /// Clears a slot, releasing the memory pools and the callback it references, and returns it to the pool.
+    /// Can be called from any thread.
+    void Release(RequestSlot* slot);
+
+    /// Returns the number of slots created by the pool
+    std::size_t GetNumSlots() const;
+
+    /// Returns the number of times the pool grew since it was created, i.e. the slots created and the times
+    /// the containers of a slot had to grow. Only the allocations of the pool itself are counted.
+    std::size_t GetNumGrowths() const { return m_NumGrowths.load(); }
+
+private:
+    RequestSlotPool(const RequestSlotPool&) = delete;
+    RequestSlotPool& operator=(const RequestSlotPool&) = delete;
+
+    template <typename Container>
+    void Reserve(Container& container, std::size_t size);
+
+    mutable std::mutex                        m_Mutex;
+    std::vector<std::unique_ptr<RequestSlot>> m_Slots;
+    std::vector<RequestSlot*>                 m_FreeSlots;
+    std::atomic<std::size_t>                  m_NumGrowths;
+};
+
+} // namespace armnn_driver
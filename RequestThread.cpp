@@ -10,18 +10,40 @@
 
 #include <boost/assert.hpp>
 
+#include <algorithm>
+#include <chrono>
+
 #include <log/log.h>
 
 using namespace android;
 
+namespace
+{
+
+// The maximum number of pending messages for each worker. Producers wait for space when a queue is full.
+const std::size_t g_RequestQueueCapacity = 256;
+
+} // anonymous namespace
+
 namespace armnn_driver
 {
 
 template<typename HalVersion>
-RequestThread<HalVersion>::RequestThread()
+RequestThread<HalVersion>::RequestThread(unsigned int numWorkers,
+                                         const ThreadSchedulingPolicy& schedulingPolicy,
+                                         const std::shared_ptr<PendingRequestLimit>& pendingRequestLimit)
+    : m_SchedulingPolicy(schedulingPolicy)
+    , m_PendingRequestLimit(pendingRequestLimit ? pendingRequestLimit : std::make_shared<PendingRequestLimit>(0))
+    , m_NextWorker(0)
 {
-    ALOGV("RequestThread::RequestThread()");
-    m_Thread = std::make_unique<std::thread>(&RequestThread::Process, this);
+    ALOGV("RequestThread::RequestThread(%u)", numWorkers);
+    const unsigned int workerCount = std::max(numWorkers, 1u);
+    m_Workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        m_Workers.emplace_back(std::make_unique<Worker>(g_RequestQueueCapacity));
+        m_Workers.back()->m_Thread = std::make_unique<std::thread>(&RequestThread::Process, this, m_Workers.back().get());
+    }
 }
 
 template<typename HalVersion>
@@ -33,92 +55,107 @@ RequestThread<HalVersion>::~RequestThread()
     {
         // Coverity fix: The following code may throw an exception of type std::length_error.
 
-        // This code is meant to to terminate the inner thread gracefully by posting an EXIT message
-        // to the thread's message queue. However, according to Coverity, this code could throw an exception and fail.
-        // Since only one static instance of RequestThread is used in the driver (in ArmnnPreparedModel),
-        // this destructor is called only when the application has been closed, which means that
-        // the inner thread will be terminated anyway, although abruptly, in the event that the destructor code throws.
+        // This code is meant to to terminate the worker threads gracefully by posting an EXIT message
+        // to each thread's message queue. However, according to Coverity, this code could throw an exception and fail.
+        // The RequestThread is owned by the driver (and shared with the prepared models it creates),
+        // so this destructor is normally called only when the application has been closed, which means that
+        // the worker threads will be terminated anyway, although abruptly, in the event that the destructor code throws.
         // Wrapping the destructor's code with a try-catch block simply fixes the Coverity bug.
 
-        // Post an EXIT message to the thread
-        std::shared_ptr<AsyncExecuteData> nulldata(nullptr);
-        auto pMsg = std::make_shared<ThreadMsg>(ThreadMsgType::EXIT, nulldata);
-        PostMsg(pMsg);
-        // Wait for the thread to terminate, it is deleted automatically
-        m_Thread->join();
+        // Post an EXIT message to every worker thread
+        for (auto& worker : m_Workers)
+        {
+            ThreadMsg msg(ThreadMsgType::EXIT, nullptr, nullptr);
+            PostMsg(*worker, msg);
+        }
+        // Wait for the threads to terminate, they are deleted automatically
+        for (auto& worker : m_Workers)
+        {
+            worker->m_Thread->join();
+        }
     }
     catch (const std::exception&) { } // Swallow any exception.
 }
 
 template<typename HalVersion>
-void RequestThread<HalVersion>::PostMsg(ArmnnPreparedModel<HalVersion>* model,
-                                        std::shared_ptr<std::vector<::android::nn::RunTimePoolInfo>>& memPools,
-                                        std::shared_ptr<armnn::InputTensors>& inputTensors,
-                                        std::shared_ptr<armnn::OutputTensors>& outputTensors,
-                                        const ::android::sp<IExecutionCallback>& callback)
+unsigned int RequestThread<HalVersion>::AssignWorker(PerformancePreference preference)
+{
+    if (preference == PerformancePreference::LowPower)
+    {
+        return 0;
+    }
+
+    // Spread the other models across the workers in a round-robin fashion
+    return m_NextWorker++ % GetNumWorkers();
+}
+
+template<typename HalVersion>
+void RequestThread<HalVersion>::PostMsg(unsigned int workerIndex,
+                                        ArmnnPreparedModel<HalVersion>* model,
+                                        RequestSlot* slot)
 {
     ALOGV("RequestThread::PostMsg(...)");
-    auto data = std::make_shared<AsyncExecuteData>(model,
-                                                   memPools,
-                                                   inputTensors,
-                                                   outputTensors,
-                                                   callback);
-    auto pMsg = std::make_shared<ThreadMsg>(ThreadMsgType::REQUEST, data);
-    PostMsg(pMsg);
+    ThreadMsg msg(ThreadMsgType::REQUEST, model, slot);
+    BOOST_ASSERT(workerIndex < m_Workers.size());
+    PostMsg(*m_Workers[workerIndex], msg);
 }
 
 template<typename HalVersion>
-void RequestThread<HalVersion>::PostMsg(std::shared_ptr<ThreadMsg>& pMsg)
+void RequestThread<HalVersion>::PostMsg(Worker& worker, ThreadMsg& msg)
 {
-    ALOGV("RequestThread::PostMsg(pMsg)");
-    // Add a message to the queue and notify the request thread
-    std::unique_lock<std::mutex> lock(m_Mutex);
-    m_Queue.push(pMsg);
-    m_Cv.notify_one();
+    ALOGV("RequestThread::PostMsg(msg)");
+    // Add a message to the queue, this wakes the worker thread if it is waiting for work
+    worker.m_Queue.Push(msg);
 }
 
 template<typename HalVersion>
-void RequestThread<HalVersion>::Process()
+void RequestThread<HalVersion>::Process(Worker* worker)
 {
     ALOGV("RequestThread::Process()");
+    if (!m_SchedulingPolicy.IsDefault())
+    {
+        // Applied by the worker itself, as the calls only affect the calling thread
+        ApplyThreadSchedulingPolicy(m_SchedulingPolicy);
+    }
+
     while (true)
     {
-        std::shared_ptr<ThreadMsg> pMsg(nullptr);
+        ThreadMsg msg;
+        if (worker->m_Urgent.empty() && worker->m_Deferred.empty())
         {
-            // Wait for a message to be added to the queue
-            // This is in a separate scope to minimise the lifetime of the lock
-            std::unique_lock<std::mutex> lock(m_Mutex);
-            while (m_Queue.empty())
-            {
-                m_Cv.wait(lock);
-            }
-            // get the message to process from the front of the queue
-            pMsg = m_Queue.front();
-            m_Queue.pop();
+            // Wait for a message to be added to the queue and get it from the front of the queue
+            worker->m_Queue.Pop(msg);
+            GetPendingMsgs(*worker, msg).push_back(msg);
         }
 
-        switch (pMsg->type)
+        // Take all the messages already posted, so that urgent requests can be executed first
+        while (worker->m_Queue.TryPop(msg))
+        {
+            GetPendingMsgs(*worker, msg).push_back(msg);
+        }
+
+        std::deque<ThreadMsg>& pendingMsgs = worker->m_Urgent.empty() ? worker->m_Deferred : worker->m_Urgent;
+        msg = pendingMsgs.front();
+        pendingMsgs.pop_front();
+
+        switch (msg.type)
         {
             case ThreadMsgType::REQUEST:
             {
                 ALOGV("RequestThread::Process() - request");
-                // invoke the asynchronous execution method
-                ArmnnPreparedModel<HalVersion>* model = pMsg->data->m_Model;
-                model->ExecuteGraph(pMsg->data->m_MemPools,
-                                    pMsg->data->m_InputTensors,
-                                    pMsg->data->m_OutputTensors,
-                                    pMsg->data->m_callback);
+                ProcessRequest(*worker, msg);
                 break;
             }
 
             case ThreadMsgType::EXIT:
             {
                 ALOGV("RequestThread::Process() - exit");
-                // delete all remaining messages (there should not be any)
-                std::unique_lock<std::mutex> lock(m_Mutex);
-                while (!m_Queue.empty())
+                // discard all remaining messages (there should not be any)
+                worker->m_Urgent.clear();
+                worker->m_Deferred.clear();
+                ThreadMsg remainingMsg;
+                while (worker->m_Queue.TryPop(remainingMsg))
                 {
-                    m_Queue.pop();
                 }
                 return;
             }
@@ -131,6 +168,83 @@ void RequestThread<HalVersion>::Process()
     }
 }
 
+template<typename HalVersion>
+std::deque<typename RequestThread<HalVersion>::ThreadMsg>& RequestThread<HalVersion>::GetPendingMsgs(
+    Worker& worker, const ThreadMsg& msg)
+{
+    // All the requests for a model go to the same list, so they are still executed in order
+    if (msg.type == ThreadMsgType::REQUEST &&
+        msg.model->GetPerformancePreference() == PerformancePreference::FastSingleAnswer)
+    {
+        return worker.m_Urgent;
+    }
+    return worker.m_Deferred;
+}
+
+template<typename HalVersion>
+void RequestThread<HalVersion>::ProcessRequest(Worker& worker, ThreadMsg& msg)
+{
+    ArmnnPreparedModel<HalVersion>* model = msg.model;
+    msg.slot->m_Timings.Record(RequestStage::Dequeued);
+    const unsigned int maxBatchSize = model->GetMaxBatchSize();
+    if (maxBatchSize <= 1)
+    {
+        // invoke the asynchronous execution method
+        model->ExecuteGraph(msg.slot);
+        return;
+    }
+
+    std::vector<RequestSlot*>& batch = worker.m_Batch;
+    batch.clear();
+    batch.push_back(msg.slot);
+
+    // Take the pending requests for the model first, to keep its requests in order
+    std::deque<ThreadMsg>& pendingMsgs = GetPendingMsgs(worker, msg);
+    for (auto it = pendingMsgs.begin(); it != pendingMsgs.end() && batch.size() < maxBatchSize;)
+    {
+        if (it->type == ThreadMsgType::REQUEST && it->model == model)
+        {
+            it->slot->m_Timings.Record(RequestStage::Dequeued);
+            batch.push_back(it->slot);
+            it = pendingMsgs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Then wait a little for more requests to fill the batch
+    const auto deadline = std::chrono::steady_clock::now() + model->GetMaxBatchWait();
+    while (batch.size() < maxBatchSize)
+    {
+        ThreadMsg next;
+        if (!worker.m_Queue.PopUntil(next, deadline))
+        {
+            break;
+        }
+
+        if (next.type == ThreadMsgType::REQUEST && next.model == model)
+        {
+            next.slot->m_Timings.Record(RequestStage::Dequeued);
+            batch.push_back(next.slot);
+        }
+        else
+        {
+            std::deque<ThreadMsg>& nextPendingMsgs = GetPendingMsgs(worker, next);
+            nextPendingMsgs.push_back(next);
+            if (&nextPendingMsgs == &worker.m_Urgent && &pendingMsgs != &worker.m_Urgent)
+            {
+                // Do not keep an urgent request waiting for this batch to fill
+                break;
+            }
+        }
+    }
+
+    ALOGV("RequestThread::ProcessRequest() - executing a batch of %zu request(s)", batch.size());
+    model->ExecuteGraphBatch(batch.data(), static_cast<unsigned int>(batch.size()));
+}
+
 ///
 /// Class template specializations
 ///
@@ -5,14 +5,18 @@
 
 #pragma once
 
-#include <queue>
+#include <atomic>
+#include <deque>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
+#include <vector>
 
-#include "ArmnnDriver.hpp"
 #include "ArmnnDriverImpl.hpp"
+#include "RequestQueue.hpp"
+#include "RequestSlotPool.hpp"
+#include "PendingRequestLimit.hpp"
+#include "ThreadScheduling.hpp"
 
+#include <HalInterfaces.h>
 #include <CpuExecutor.h>
 #include <armnn/ArmNN.hpp>
 
@@ -26,82 +30,114 @@ template<typename HalVersion>
 class RequestThread
 {
 public:
-    /// Constructor creates the thread
-    RequestThread();
-
-    /// Destructor terminates the thread
+    /// Constructor creates the worker threads
+    /// @param[in] numWorkers the number of worker threads executing requests (at least one is always created)
+    /// @param[in] schedulingPolicy the CPU affinity and priority each worker thread applies when it starts
+    /// @param[in] pendingRequestLimit the limit on the requests pending for all the models of the driver,
+    ///            which may be shared with other request threads. No limit is applied if it is null.
+    RequestThread(unsigned int numWorkers = 1,
+                  const ThreadSchedulingPolicy& schedulingPolicy = ThreadSchedulingPolicy(),
+                  const std::shared_ptr<PendingRequestLimit>& pendingRequestLimit = nullptr);
+
+    /// Destructor terminates the worker threads
     ~RequestThread();
 
-    /// Add a message to the thread queue.
-    /// @param[in] model pointer to the prepared model handling the request
-    /// @param[in] memPools pointer to the memory pools vector for the tensors
-    /// @param[in] inputTensors pointer to the input tensors for the request
-    /// @param[in] outputTensors pointer to the output tensors for the request
-    /// @param[in] callback the android notification callback
-    void PostMsg(armnn_driver::ArmnnPreparedModel<HalVersion>* model,
-                 std::shared_ptr<std::vector<::android::nn::RunTimePoolInfo>>& memPools,
-                 std::shared_ptr<armnn::InputTensors>& inputTensors,
-                 std::shared_ptr<armnn::OutputTensors>& outputTensors,
-                 const ::android::sp<IExecutionCallback>& callback);
+    /// Returns the number of worker threads
+    unsigned int GetNumWorkers() const { return static_cast<unsigned int>(m_Workers.size()); }
+
+    /// Returns the limit on the requests pending for all the models, which also counts them
+    PendingRequestLimit& GetPendingRequestLimit() { return *m_PendingRequestLimit; }
+
+    /// Selects the worker that will execute all the requests for a newly prepared model.
+    /// Requests posted to one worker are executed in order, so a network never runs concurrently with itself,
+    /// while networks assigned to different workers can be executed in parallel.
+    /// Models prepared for low power all share the first worker, to keep fewer threads busy.
+    /// @param[in] preference the preference the model was prepared with
+    /// @return the index of the worker to pass to PostMsg
+    unsigned int AssignWorker(PerformancePreference preference);
+
+    /// Add a message to the queue of the given worker thread.
+    /// @param[in] workerIndex the worker assigned to the model by AssignWorker
+    /// @param[in] model pointer to the prepared model handling the request, which waits for the request to be
+    ///            processed before it is destroyed, see ArmnnPreparedModel::FinishPostedRequests
+    /// @param[in] slot the request slot holding the memory pools, tensors and callback of the request,
+    ///            acquired from the request slot pool of the model
+    void PostMsg(unsigned int workerIndex,
+                 armnn_driver::ArmnnPreparedModel<HalVersion>* model,
+                 RequestSlot* slot);
 
 private:
     RequestThread(const RequestThread&) = delete;
     RequestThread& operator=(const RequestThread&) = delete;
 
-    /// storage for a prepared model and args for the asyncExecute call
-    struct AsyncExecuteData
-    {
-        AsyncExecuteData(ArmnnPreparedModel<HalVersion>* model,
-                         std::shared_ptr<std::vector<::android::nn::RunTimePoolInfo>>& memPools,
-                         std::shared_ptr<armnn::InputTensors>& inputTensors,
-                         std::shared_ptr<armnn::OutputTensors>& outputTensors,
-                         const ::android::sp<IExecutionCallback>& cb)
-            : m_Model(model)
-            , m_MemPools(memPools)
-            , m_InputTensors(inputTensors)
-            , m_OutputTensors(outputTensors)
-            , m_callback(cb)
-        {
-        }
-
-        armnn_driver::ArmnnPreparedModel<HalVersion>* m_Model;
-        std::shared_ptr<std::vector<::android::nn::RunTimePoolInfo>> m_MemPools;
-        std::shared_ptr<armnn::InputTensors> m_InputTensors;
-        std::shared_ptr<armnn::OutputTensors> m_OutputTensors;
-        const ::android::sp<IExecutionCallback> m_callback;
-    };
-
     enum class ThreadMsgType
     {
         EXIT,                   // exit the thread
         REQUEST                 // user request to process
     };
 
-    /// storage for the thread message type and data
+    /// storage for the thread message type and data.
+    /// Messages are copied into the queue by value, so posting one does not allocate.
     struct ThreadMsg
     {
+        ThreadMsg()
+            : type(ThreadMsgType::EXIT)
+            , model(nullptr)
+            , slot(nullptr)
+        {
+        }
+
         ThreadMsg(ThreadMsgType msgType,
-                  std::shared_ptr<AsyncExecuteData>& msgData)
+                  ArmnnPreparedModel<HalVersion>* msgModel,
+                  RequestSlot* msgSlot)
             : type(msgType)
-            , data(msgData)
+            , model(msgModel)
+            , slot(msgSlot)
         {
         }
 
         ThreadMsgType type;
-        std::shared_ptr<AsyncExecuteData> data;
+        ArmnnPreparedModel<HalVersion>* model;
+        RequestSlot* slot;
     };
 
-    /// Add a prepared thread message to the thread queue.
+    /// A worker thread together with its own message queue.
+    /// The queue has many producers (the binder threads calling execute) and a single consumer (the worker).
+    struct Worker
+    {
+        Worker(std::size_t queueCapacity)
+            : m_Queue(queueCapacity)
+        {
+        }
+
+        std::unique_ptr<std::thread> m_Thread;
+        RequestQueue<ThreadMsg> m_Queue;
+        // Messages taken from the queue but not processed yet, in the order they were posted. The requests for
+        // models prepared for fast single answers are kept apart, so that they overtake the other requests.
+        std::deque<ThreadMsg> m_Urgent;
+        std::deque<ThreadMsg> m_Deferred;
+        // The requests of the batch being collected
+        std::vector<RequestSlot*> m_Batch;
+    };
+
+    /// Add a prepared thread message to the queue of a worker thread.
+    /// @param[in] worker the worker to post the message to
     /// @param[in] threadMsg the message to add to the queue
-    void PostMsg(std::shared_ptr<ThreadMsg>& pThreadMsg);
+    void PostMsg(Worker& worker, ThreadMsg& threadMsg);
+
+    /// Entry point for the worker threads
+    void Process(Worker* worker);
+
+    /// Returns the list a message taken from the queue waits in until it is processed
+    std::deque<ThreadMsg>& GetPendingMsgs(Worker& worker, const ThreadMsg& msg);
 
-    /// Entry point for the request thread
-    void Process();
+    /// Executes a request, together with the other pending requests for the same model if it supports batching
+    void ProcessRequest(Worker& worker, ThreadMsg& msg);
 
-    std::unique_ptr<std::thread> m_Thread;
-    std::queue<std::shared_ptr<ThreadMsg>> m_Queue;
-    std::mutex m_Mutex;
-    std::condition_variable m_Cv;
+    const ThreadSchedulingPolicy m_SchedulingPolicy;
+    std::shared_ptr<PendingRequestLimit> m_PendingRequestLimit;
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+    std::atomic<unsigned int> m_NextWorker;
 };
 
-} // namespace armnn_driver
\ No newline at end of file
+} // namespace armnn_driver
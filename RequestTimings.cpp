@@ -0,0 +1,199 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "RequestTimings.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/format.hpp>
+#include <log/log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+using namespace armnn_driver;
+
+// The names of the steps ending at each stage
+const char* g_StepNames[] =
+{
+    "total",                // the whole request, from RequestStage::Received to RequestStage::Notified
+    "validate",
+    "map_pools",
+    "enqueue",
+    "queue_wait",
+    "prepare_workload",
+    "workload",
+    "commit",
+    "notify"
+};
+
+static_assert(sizeof(g_StepNames) / sizeof(g_StepNames[0]) == static_cast<unsigned int>(RequestStage::NumStages),
+              "A name is required for each request stage");
+
+} // anonymous namespace
+
+namespace armnn_driver
+{
+
+LatencyHistogram::LatencyHistogram()
+    : m_Count(0)
+{
+    for (auto& bucket : m_Buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+unsigned int LatencyHistogram::GetBucketIndex(uint64_t value)
+{
+    if (value < NumSubBuckets)
+    {
+        return static_cast<unsigned int>(value);
+    }
+
+    // The position of the most significant bit selects the power of two, the next 3 bits the sub-bucket
+    const unsigned int msb = 63u - static_cast<unsigned int>(__builtin_clzll(value));
+    const unsigned int subBucket = static_cast<unsigned int>(value >> (msb - 3)) - NumSubBuckets;
+    return std::min((msb - 2) * NumSubBuckets + subBucket, NumBuckets - 1);
+}
+
+uint64_t LatencyHistogram::GetBucketValue(unsigned int index)
+{
+    if (index < NumSubBuckets)
+    {
+        return index;
+    }
+
+    // The middle of the bucket
+    const unsigned int msb = index / NumSubBuckets + 2;
+    const uint64_t subBucket = index % NumSubBuckets;
+    const uint64_t width = uint64_t(1) << (msb - 3);
+    return (NumSubBuckets + subBucket) * width + width / 2;
+}
+
+void LatencyHistogram::Add(std::chrono::microseconds duration)
+{
+    const uint64_t value = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+    m_Buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_Count.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const
+{
+    // The buckets may be updated while they are read, so the count is recomputed from them
+    uint64_t count = 0;
+    for (const auto& bucket : m_Buckets)
+    {
+        count += bucket.load(std::memory_order_relaxed);
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)));
+    uint64_t cumulative = 0;
+    for (unsigned int i = 0; i < NumBuckets; ++i)
+    {
+        cumulative += m_Buckets[i].load(std::memory_order_relaxed);
+        if (cumulative >= rank)
+        {
+            return GetBucketValue(i);
+        }
+    }
+    return GetBucketValue(NumBuckets - 1);
+}
+
+RequestLatencyStats::RequestLatencyStats(unsigned int logPeriod)
+    : m_LogPeriod(logPeriod)
+{
+}
+
+void RequestLatencyStats::Add(const RequestTimings& timings)
+{
+    using namespace std::chrono;
+
+    for (unsigned int stage = 1; stage < NumStages; ++stage)
+    {
+        m_Steps[stage].Add(duration_cast<microseconds>(timings.m_Timestamps[stage] -
+                                                       timings.m_Timestamps[stage - 1]));
+    }
+    m_Total.Add(duration_cast<microseconds>(timings.m_Timestamps[NumStages - 1] - timings.m_Timestamps[0]));
+
+    if (m_LogPeriod != 0 && GetNumRequests() % m_LogPeriod == 0)
+    {
+        ALOGI("Request latencies (p50/p95/p99 in us): %s", GetSummary().c_str());
+    }
+}
+
+const LatencyHistogram& RequestLatencyStats::GetHistogram(RequestStage stage) const
+{
+    const unsigned int index = static_cast<unsigned int>(stage);
+    BOOST_ASSERT(index < NumStages);
+    return index == 0 ? m_Total : m_Steps[index];
+}
+
+std::string RequestLatencyStats::GetSummary() const
+{
+    std::stringstream summary;
+    summary << GetNumRequests() << " requests";
+    for (unsigned int stage = 0; stage < NumStages; ++stage)
+    {
+        const LatencyHistogram& histogram = GetHistogram(static_cast<RequestStage>(stage));
+        summary << ", " << g_StepNames[stage] << " " << histogram.GetPercentile(50) << "/"
+                << histogram.GetPercentile(95) << "/" << histogram.GetPercentile(99);
+    }
+    return summary.str();
+}
+
+void RequestLatencyStats::DumpJson(const std::string& dumpDir,
+                                   armnn::NetworkId networkId,
+                                   unsigned int preparedModelId) const
+{
+    // The dump directory must exist in advance.
+    if (dumpDir.empty() || GetNumRequests() == 0)
+    {
+        return;
+    }
+
+    const std::string fileName = boost::str(boost::format("%1%/%2%_%3%_latency.json")
+                                            % dumpDir
+                                            % std::to_string(networkId)
+                                            % std::to_string(preparedModelId));
+
+    std::ofstream fileStream;
+    fileStream.open(fileName, std::ofstream::out | std::ofstream::trunc);
+
+    if (!fileStream.good())
+    {
+        ALOGW("Could not open file %s for writing", fileName.c_str());
+        return;
+    }
+
+    fileStream << "{\n";
+    fileStream << "  \"network_id\": " << networkId << ",\n";
+    fileStream << "  \"prepared_model_id\": " << preparedModelId << ",\n";
+    fileStream << "  \"requests\": " << GetNumRequests() << ",\n";
+    fileStream << "  \"steps\": [\n";
+    for (unsigned int stage = 0; stage < NumStages; ++stage)
+    {
+        const LatencyHistogram& histogram = GetHistogram(static_cast<RequestStage>(stage));
+        fileStream << "    { \"name\": \"" << g_StepNames[stage] << "\""
+                   << ", \"p50_us\": " << histogram.GetPercentile(50)
+                   << ", \"p95_us\": " << histogram.GetPercentile(95)
+                   << ", \"p99_us\": " << histogram.GetPercentile(99)
+                   << " }" << (stage + 1 < NumStages ? "," : "") << "\n";
+    }
+    fileStream << "  ]\n";
+    fileStream << "}\n";
+}
+
+} // namespace armnn_driver
@@ -0,0 +1,111 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <armnn/ArmNN.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace armnn_driver
+{
+
+/// The points in the life of a request at which a timestamp is taken, in the order they are reached
+enum class RequestStage : unsigned int
+{
+    Received,               // execute() was called
+    Validated,              // the request was validated against the model
+    PoolsMapped,            // the memory pools of the request were mapped and its arguments bound
+    Enqueued,               // the request was posted to the request thread
+    Dequeued,               // the request thread took the request to execute it
+    WorkloadStarted,        // EnqueueWorkload was called
+    WorkloadFinished,       // EnqueueWorkload returned
+    Committed,              // the output memory pools were committed
+    Notified,               // the callback of the request was notified
+    NumStages
+};
+
+/// The timestamps taken during the execution of a request
+struct RequestTimings
+{
+    using Clock = std::chrono::steady_clock;
+
+    void Record(RequestStage stage) { Set(stage, Clock::now()); }
+
+    void Set(RequestStage stage, Clock::time_point time) { m_Timestamps[static_cast<unsigned int>(stage)] = time; }
+
+    Clock::time_point Get(RequestStage stage) const { return m_Timestamps[static_cast<unsigned int>(stage)]; }
+
+    std::array<Clock::time_point, static_cast<unsigned int>(RequestStage::NumStages)> m_Timestamps;
+};
+
+/// A histogram of durations with logarithmic buckets, each power of two being split into 8 buckets,
+/// so that the percentiles are accurate to within 12.5%. Adding a value is lock-free and can be done
+/// from any thread.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void Add(std::chrono::microseconds duration);
+
+    /// Returns the number of durations added
+    uint64_t GetCount() const { return m_Count.load(std::memory_order_relaxed); }
+
+    /// Returns an approximation of the given percentile in microseconds, 0 if the histogram is empty
+    /// @param[in] percentile between 0 and 100
+    uint64_t GetPercentile(double percentile) const;
+
+private:
+    static const unsigned int NumSubBuckets = 8;
+    // Enough buckets for durations of more than an hour
+    static const unsigned int NumBuckets = 40 * NumSubBuckets;
+
+    static unsigned int GetBucketIndex(uint64_t value);
+    static uint64_t GetBucketValue(unsigned int index);
+
+    std::array<std::atomic<uint32_t>, NumBuckets> m_Buckets;
+    std::atomic<uint64_t>                         m_Count;
+};
+
+/// Aggregates the timings of the requests executed by a prepared model into a histogram for each step
+/// between consecutive stages, and one for the whole request
+class RequestLatencyStats
+{
+public:
+    /// @param[in] logPeriod the number of requests between two summaries written to the log, 0 to never log
+    RequestLatencyStats(unsigned int logPeriod);
+
+    /// Adds the timings of a completed request. Can be called from any thread.
+    void Add(const RequestTimings& timings);
+
+    /// Returns the number of requests added
+    uint64_t GetNumRequests() const { return m_Total.GetCount(); }
+
+    /// Returns the histogram of the step ending at the given stage, e.g. RequestStage::Dequeued for the time
+    /// spent in the queue, or the histogram of the whole request for RequestStage::Received
+    const LatencyHistogram& GetHistogram(RequestStage stage) const;
+
+    /// Returns the p50, p95 and p99 of each step, on one line
+    std::string GetSummary() const;
+
+    /// Writes the p50, p95 and p99 of each step to <dumpDir>/<networkId>_<preparedModelId>_latency.json.
+    /// Does nothing if the dump directory is empty or no request was executed.
+    void DumpJson(const std::string& dumpDir, armnn::NetworkId networkId, unsigned int preparedModelId) const;
+
+private:
+    static const unsigned int NumStages = static_cast<unsigned int>(RequestStage::NumStages);
+
+    // The histogram at index i is for the step ending at stage i, there is no step ending at RequestStage::Received
+    std::array<LatencyHistogram, NumStages> m_Steps;
+    LatencyHistogram                        m_Total;
+    const unsigned int                      m_LogPeriod;
+};
+
+} // namespace armnn_driver
@@ -0,0 +1,113 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#define LOG_TAG "ArmnnDriver"
+
+#include "ThreadScheduling.hpp"
+
+#include <log/log.h>
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+namespace armnn_driver
+{
+
+bool ParseCpuList(const std::string& cpuList, std::set<unsigned int>& cpus)
+{
+    cpus.clear();
+
+    std::istringstream listStream(cpuList);
+    std::string item;
+    while (std::getline(listStream, item, ','))
+    {
+        unsigned int first = 0;
+        unsigned int last = 0;
+        char separator = 0;
+        char extra = 0;
+        std::istringstream itemStream(item);
+        if (!(itemStream >> first))
+        {
+            cpus.clear();
+            return false;
+        }
+        last = first;
+        if (itemStream >> separator && (separator != '-' || !(itemStream >> last) || itemStream >> extra))
+        {
+            cpus.clear();
+            return false;
+        }
+        if (last < first || last >= CPU_SETSIZE)
+        {
+            cpus.clear();
+            return false;
+        }
+
+        for (unsigned int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.insert(cpu);
+        }
+    }
+
+    return !cpus.empty();
+}
+
+bool ApplyThreadSchedulingPolicy(const ThreadSchedulingPolicy& policy)
+{
+    bool success = true;
+
+    // The calls below apply to the calling thread only, as Linux schedules each thread as its own task
+    const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+
+    if (!policy.m_Cpus.empty())
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (unsigned int cpu : policy.m_Cpus)
+        {
+            CPU_SET(cpu, &cpuSet);
+        }
+
+        if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+        {
+            ALOGW("ApplyThreadSchedulingPolicy: could not set the CPU affinity of thread %d: %s",
+                  tid, strerror(errno));
+            success = false;
+        }
+    }
+
+    if (policy.m_Nice != 0)
+    {
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), policy.m_Nice) != 0)
+        {
+            ALOGW("ApplyThreadSchedulingPolicy: could not set the nice value of thread %d to %d: %s",
+                  tid, policy.m_Nice, strerror(errno));
+            success = false;
+        }
+    }
+
+    if (policy.m_FifoPriority != 0)
+    {
+        sched_param param = {};
+        param.sched_priority = std::min(static_cast<int>(policy.m_FifoPriority), sched_get_priority_max(SCHED_FIFO));
+        if (sched_setscheduler(0, SCHED_FIFO, &param) != 0)
+        {
+            ALOGW("ApplyThreadSchedulingPolicy: could not use SCHED_FIFO with priority %d for thread %d: %s",
+                  param.sched_priority, tid, strerror(errno));
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+} // namespace armnn_driver
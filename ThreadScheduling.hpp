@@ -0,0 +1,43 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <set>
+#include <string>
+
+namespace armnn_driver
+{
+
+/// How the threads executing requests are scheduled, to keep them on the fast cores of the device and
+/// get repeatable latencies. The default policy leaves the threads as the system creates them.
+struct ThreadSchedulingPolicy
+{
+    ThreadSchedulingPolicy()
+        : m_Nice(0)
+        , m_FifoPriority(0)
+    {
+    }
+
+    bool IsDefault() const { return m_Cpus.empty() && m_Nice == 0 && m_FifoPriority == 0; }
+
+    // The CPUs the threads may run on, all of them if empty
+    std::set<unsigned int> m_Cpus;
+    // The nice value of the threads, 0 to leave it unchanged
+    int                    m_Nice;
+    // The SCHED_FIFO real-time priority of the threads, 0 to keep the default time-sharing policy
+    unsigned int           m_FifoPriority;
+};
+
+/// Parses a list of CPUs made of indexes and ranges, e.g. "0-3,6"
+/// @return false if the list is malformed, in which case cpus is left empty
+bool ParseCpuList(const std::string& cpuList, std::set<unsigned int>& cpus);
+
+/// Applies a scheduling policy to the calling thread. Each setting that cannot be applied, e.g. SCHED_FIFO when
+/// the driver lacks the permission to use it, is logged and skipped, the thread keeps running regardless.
+/// @return true if every setting was applied
+bool ApplyThreadSchedulingPolicy(const ThreadSchedulingPolicy& policy);
+
+} // namespace armnn_driver
@@ -9,6 +9,7 @@
 
 #include <Permute.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 
@@ -54,13 +55,8 @@ void SwizzleAndroidNn4dTensorToArmNn(const armnn::TensorInfo& tensor, const void
     }
 }
 
-void* GetMemoryFromPool(DataLocation location, const std::vector<android::nn::RunTimePoolInfo>& memPools)
+void* GetMemoryFromPool(DataLocation location, const android::nn::RunTimePoolInfo& memPool)
 {
-    // find the location within the pool
-    assert(location.poolIndex < memPools.size());
-
-    const android::nn::RunTimePoolInfo& memPool = memPools[location.poolIndex];
-
     // Type android::nn::RunTimePoolInfo has changed between Android O and Android P, where
     // "buffer" has been made private and must be accessed via the accessor method "getBuffer".
 #if defined(ARMNN_ANDROID_P) // Use the new Android P implementation.
@@ -74,6 +70,58 @@ void* GetMemoryFromPool(DataLocation location, const std::vector<android::nn::Ru
     return memory;
 }
 
+void* GetMemoryFromPool(DataLocation location, const std::vector<android::nn::RunTimePoolInfo>& memPools)
+{
+    // find the location within the pool
+    assert(location.poolIndex < memPools.size());
+
+    return GetMemoryFromPool(location, memPools[location.poolIndex]);
+}
+
+void* GetMemoryFromPool(DataLocation location,
+                        const std::vector<std::shared_ptr<android::nn::RunTimePoolInfo>>& memPools)
+{
+    // find the location within the pool
+    assert(location.poolIndex < memPools.size());
+
+    return GetMemoryFromPool(location, *memPools[location.poolIndex]);
+}
+
+std::shared_ptr<android::nn::RunTimePoolInfo> MapRunTimePoolInfo(const hidl_memory& memory)
+{
+    // The RunTimePoolInfo constructor has changed between Android O and Android P, where
+    // the memory is mapped on construction rather than by the "set" method.
+#if defined(ARMNN_ANDROID_P) // Use the new Android P implementation.
+    bool fail = false;
+    auto poolInfo = std::make_shared<android::nn::RunTimePoolInfo>(memory, &fail);
+    if (fail)
+    {
+        return nullptr;
+    }
+#else // Fallback to the old Android O implementation.
+    auto poolInfo = std::make_shared<android::nn::RunTimePoolInfo>();
+    if (!poolInfo->set(memory))
+    {
+        return nullptr;
+    }
+#endif
+    return poolInfo;
+}
+
+void GetOutputPoolIndexes(const Request& request, std::vector<uint32_t>& poolIndexes)
+{
+    poolIndexes.clear();
+    for (const RequestArgument& output : request.outputs)
+    {
+        const uint32_t poolIndex = output.location.poolIndex;
+        // A request has few outputs, so a linear search is cheaper than sorting
+        if (std::find(poolIndexes.begin(), poolIndexes.end(), poolIndex) == poolIndexes.end())
+        {
+            poolIndexes.push_back(poolIndex);
+        }
+    }
+}
+
 armnn::TensorInfo GetTensorInfoForOperand(const Operand& operand)
 {
     armnn::DataType type;
@@ -101,6 +149,12 @@ armnn::TensorInfo GetTensorInfoForOperand(const Operand& operand)
     return ret;
 }
 
+std::mutex& GetNetworkLoadingMutex()
+{
+    static std::mutex networkLoadingMutex;
+    return networkLoadingMutex;
+}
+
 std::string GetOperandSummary(const Operand& operand)
 {
     return android::hardware::details::arrayToString(operand.dimensions, operand.dimensions.size()) + " " +
@@ -248,6 +302,7 @@ void DumpTensor(const std::string& dumpDir,
 void DumpJsonProfilingIfRequired(bool gpuProfilingEnabled,
                                  const std::string& dumpDir,
                                  armnn::NetworkId networkId,
+                                 unsigned int preparedModelId,
                                  const armnn::IProfiler* profiler)
 {
     // Check if profiling is required.
@@ -264,10 +319,11 @@ void DumpJsonProfilingIfRequired(bool gpuProfilingEnabled,
 
     BOOST_ASSERT(profiler);
 
-    // Set the name of the output profiling file.
-    const std::string fileName = boost::str(boost::format("%1%/%2%_%3%.json")
+    // Set the name of the output profiling file. The prepared models sharing the network write separate files.
+    const std::string fileName = boost::str(boost::format("%1%/%2%_%3%_%4%.json")
                                             % dumpDir
                                             % std::to_string(networkId)
+                                            % std::to_string(preparedModelId)
                                             % "profiling");
 
     // Open the ouput file for writing.
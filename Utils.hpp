@@ -14,6 +14,8 @@
 #include <boost/format.hpp>
 #include <log/log.h>
 
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <fstream>
@@ -39,10 +41,31 @@ public:
 void SwizzleAndroidNn4dTensorToArmNn(const armnn::TensorInfo& tensor, const void* input, void* output,
                                      const armnn::PermutationVector& mappings);
 
+/// Returns a pointer to a specific location in a pool, ignoring its pool index
+void* GetMemoryFromPool(DataLocation location, const android::nn::RunTimePoolInfo& memPool);
+
 /// Returns a pointer to a specific location in a pool
 void* GetMemoryFromPool(DataLocation location,
                         const std::vector<android::nn::RunTimePoolInfo>& memPools);
 
+/// Returns a pointer to a specific location in a pool
+void* GetMemoryFromPool(DataLocation location,
+                        const std::vector<std::shared_ptr<android::nn::RunTimePoolInfo>>& memPools);
+
+/// Maps a memory pool, returning nullptr if the mapping fails
+std::shared_ptr<android::nn::RunTimePoolInfo> MapRunTimePoolInfo(const hidl_memory& memory);
+
+/// Collects the indexes of the pools referenced by the outputs of a request, i.e. the pools that must be
+/// committed after the request is executed. Each index is only listed once.
+/// @param[in] request the request to inspect
+/// @param[out] poolIndexes the indexes of the output pools, the previous content is cleared
+void GetOutputPoolIndexes(const Request& request, std::vector<uint32_t>& poolIndexes);
+
+/// Returns the mutex serialising the loading and unloading of networks in the runtime.
+/// Models are prepared and released concurrently on the binder threads, and the runtime does not synchronise
+/// the changes to its set of loaded networks.
+std::mutex& GetNetworkLoadingMutex();
+
 /// Can throw UnsupportedOperand
 armnn::TensorInfo GetTensorInfoForOperand(const Operand& operand);
 
@@ -80,6 +103,30 @@ std::string GetModelSummary(const HalModel& model)
     return result.str();
 }
 
+/// Returns a model holding only the input and output operands of a model, which is all android::nn::validateRequest
+/// reads. Its operations, constant values and memory pools are left empty.
+template <typename HalModel>
+HalModel GetInputsAndOutputsModel(const HalModel& model)
+{
+    HalModel result = {};
+    result.operands.resize(model.inputIndexes.size() + model.outputIndexes.size());
+    result.inputIndexes.resize(model.inputIndexes.size());
+    result.outputIndexes.resize(model.outputIndexes.size());
+
+    uint32_t operandIndex = 0;
+    for (uint32_t i = 0; i < model.inputIndexes.size(); i++)
+    {
+        result.operands[operandIndex] = model.operands[model.inputIndexes[i]];
+        result.inputIndexes[i] = operandIndex++;
+    }
+    for (uint32_t i = 0; i < model.outputIndexes.size(); i++)
+    {
+        result.operands[operandIndex] = model.operands[model.outputIndexes[i]];
+        result.outputIndexes[i] = operandIndex++;
+    }
+    return result;
+}
+
 void DumpTensor(const std::string& dumpDir,
                 const std::string& requestName,
                 const std::string& tensorName,
@@ -88,6 +135,7 @@ void DumpTensor(const std::string& dumpDir,
 void DumpJsonProfilingIfRequired(bool gpuProfilingEnabled,
                                  const std::string& dumpDir,
                                  armnn::NetworkId networkId,
+                                 unsigned int preparedModelId,
                                  const armnn::IProfiler* profiler);
 
 template <typename HalModel>
@@ -18,9 +18,12 @@ using namespace std;
 int main(int argc, char** argv)
 {
     android::sp<ArmnnDriver> driver;
+    unsigned int numBinderThreads = 1;
     try
     {
-        driver = new ArmnnDriver(DriverOptions(argc, argv));
+        DriverOptions options(argc, argv);
+        numBinderThreads = options.GetNumberOfBinderThreads();
+        driver = new ArmnnDriver(std::move(options));
     }
     catch (const std::exception& e)
     {
@@ -28,7 +31,7 @@ int main(int argc, char** argv)
         return EXIT_FAILURE;
     }
 
-    android::hardware::configureRpcThreadpool(1, true);
+    android::hardware::configureRpcThreadpool(numBinderThreads, true);
     android::status_t status = android::UNKNOWN_ERROR;
     try
     {
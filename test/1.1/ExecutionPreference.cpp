@@ -0,0 +1,186 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "../DriverTestHelpers.hpp"
+#include "../../RequestThread.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ExecutionPreferenceTests)
+
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+// Large enough for each request to take a while on CpuRef
+const uint32_t g_NumUnits = 512;
+
+// Records the order in which the requests complete
+class OrderedExecutionCallback : public ExecutionCallback
+{
+public:
+    OrderedExecutionCallback(std::vector<unsigned int>& order, std::mutex& mutex, unsigned int id)
+        : m_Order(order)
+        , m_Mutex(mutex)
+        , m_Id(id)
+    {}
+
+    Return<void> notify(ErrorStatus status) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Order.push_back(m_Id);
+        }
+        return ExecutionCallback::notify(status);
+    }
+
+private:
+    std::vector<unsigned int>& m_Order;
+    std::mutex&                m_Mutex;
+    unsigned int               m_Id;
+};
+
+V1_1::Model CreateFullyConnectedModel()
+{
+    V1_1::Model model = {};
+
+    const std::vector<float> weights(g_NumUnits * g_NumUnits, 0.5f);
+    const std::vector<float> bias(g_NumUnits, 1.0f);
+    int32_t actValue = 0;
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, g_NumUnits});
+    AddTensorOperand(model, hidl_vec<uint32_t>{g_NumUnits, g_NumUnits}, weights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{g_NumUnits}, bias);
+    AddIntOperand(model, actValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, g_NumUnits});
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_1::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    return model;
+}
+
+android::sp<IPreparedModel> PrepareModelWithPreference(const V1_1::Model& model,
+                                                       ArmnnDriver& driver,
+                                                       V1_1::ExecutionPreference preference)
+{
+    android::sp<PreparedModelCallback> cb(new PreparedModelCallback());
+    driver.prepareModel_1_1(model, preference, cb);
+    cb->wait();
+    BOOST_TEST(cb->GetErrorStatus() == ErrorStatus::NONE);
+    return cb->GetPreparedModel();
+}
+
+Request CreateRequest()
+{
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    const std::vector<float> indata(g_NumUnits, 1.0f);
+    AddPoolAndSetData(g_NumUnits, request, indata.data());
+    AddPoolAndGetData(g_NumUnits, request);
+    return request;
+}
+
+} // anonymous namespace
+
+// Requests for a model prepared for fast single answers overtake the queued requests of other models
+BOOST_AUTO_TEST_CASE(FastSingleAnswerOvertakesSustainedSpeed)
+{
+    // A single request thread, so that both models share the same queue
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({
+        "--compute", "CpuRef",
+        "--request-threads", "1" }));
+
+    const V1_1::Model model = CreateFullyConnectedModel();
+    android::sp<IPreparedModel> sustainedModel =
+        PrepareModelWithPreference(model, *driver, V1_1::ExecutionPreference::SUSTAINED_SPEED);
+    android::sp<IPreparedModel> fastModel =
+        PrepareModelWithPreference(model, *driver, V1_1::ExecutionPreference::FAST_SINGLE_ANSWER);
+
+    const unsigned int numSustainedRequests = 16;
+    std::vector<Request> requests;
+    for (unsigned int i = 0; i <= numSustainedRequests; ++i)
+    {
+        requests.push_back(CreateRequest());
+    }
+
+    std::vector<unsigned int> completionOrder;
+    std::mutex completionMutex;
+    std::vector<android::sp<OrderedExecutionCallback>> callbacks;
+    for (unsigned int i = 0; i <= numSustainedRequests; ++i)
+    {
+        callbacks.push_back(new OrderedExecutionCallback(completionOrder, completionMutex, i));
+    }
+
+    // Queue the requests for the sustained speed model, then one for the fast single answer model
+    for (unsigned int i = 0; i < numSustainedRequests; ++i)
+    {
+        BOOST_TEST(sustainedModel->execute(requests[i], callbacks[i]) == ErrorStatus::NONE);
+    }
+    BOOST_TEST(fastModel->execute(requests[numSustainedRequests], callbacks[numSustainedRequests]) ==
+               ErrorStatus::NONE);
+
+    for (auto& callback : callbacks)
+    {
+        callback->wait();
+    }
+
+    // The sustained speed requests still complete in the order they were posted
+    std::vector<unsigned int> sustainedOrder;
+    std::copy_if(completionOrder.begin(), completionOrder.end(), std::back_inserter(sustainedOrder),
+                 [numSustainedRequests](unsigned int id) { return id != numSustainedRequests; });
+    BOOST_TEST(std::is_sorted(sustainedOrder.begin(), sustainedOrder.end()));
+
+    // The fast single answer request only waits for the requests already executing, not for the whole queue
+    const auto fastPosition = std::find(completionOrder.begin(), completionOrder.end(), numSustainedRequests) -
+                              completionOrder.begin();
+    BOOST_TEST_MESSAGE("The fast single answer request completed at position " << fastPosition << " of "
+                       << completionOrder.size());
+    BOOST_TEST(fastPosition < numSustainedRequests / 2);
+}
+
+// Models prepared for low power are not spread across the request threads
+BOOST_AUTO_TEST_CASE(LowPowerUsesOneWorker)
+{
+    RequestThread<hal_1_1::HalPolicy> requestThread(4);
+
+    BOOST_TEST(requestThread.AssignWorker(PerformancePreference::LowPower) == 0);
+    BOOST_TEST(requestThread.AssignWorker(PerformancePreference::LowPower) == 0);
+
+    BOOST_TEST(requestThread.AssignWorker(PerformancePreference::SustainedSpeed) == 0);
+    BOOST_TEST(requestThread.AssignWorker(PerformancePreference::FastSingleAnswer) == 1);
+    BOOST_TEST(requestThread.AssignWorker(PerformancePreference::SustainedSpeed) == 2);
+    BOOST_TEST(requestThread.AssignWorker(PerformancePreference::LowPower) == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
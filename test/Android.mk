@@ -47,14 +47,30 @@ LOCAL_SRC_FILES := \
         1.0/Convolution2D.cpp \
         Tests.cpp \
         UtilsTests.cpp \
+        Batching.cpp \
+        ClientDeath.cpp \
         Concurrent.cpp \
+        ConstTensorStoreTests.cpp \
+        ConvertedNetworkCacheTests.cpp \
+        LoadedNetworkBudgetTests.cpp \
+        OperationSupportCacheTests.cpp \
+        RequestQueueTests.cpp \
+        PendingRequestLimitTests.cpp \
+        PreparationPoolTests.cpp \
+        PrepareReportTests.cpp \
+        PreparedNetworkCacheTests.cpp \
+        ProgramCacheTests.cpp \
+        RequestSlotPoolTests.cpp \
+        RequestTimingsTests.cpp \
+        WarmUp.cpp \
         FullyConnected.cpp \
         GenericLayerTests.cpp \
         DriverTestHelpers.cpp \
         SystemProperties.cpp \
         Lstm.cpp \
         Merger.cpp \
-        TestTensor.cpp
+        TestTensor.cpp \
+        ThreadSchedulingTests.cpp
 
 LOCAL_STATIC_LIBRARIES := \
         libneuralnetworks_common \
@@ -69,6 +85,7 @@ LOCAL_WHOLE_STATIC_LIBRARIES := \
 
 LOCAL_SHARED_LIBRARIES := \
         libbase \
+        libcrypto \
         libhidlbase \
         libhidltransport \
         libhidlmemory \
@@ -121,18 +138,35 @@ LOCAL_CFLAGS := \
 LOCAL_SRC_FILES := \
         1.0/Convolution2D.cpp \
         1.1/Convolution2D.cpp \
+        1.1/ExecutionPreference.cpp \
         1.1/Mean.cpp \
         1.1/Transpose.cpp \
         Tests.cpp \
         UtilsTests.cpp \
+        Batching.cpp \
+        ClientDeath.cpp \
         Concurrent.cpp \
+        ConstTensorStoreTests.cpp \
+        ConvertedNetworkCacheTests.cpp \
+        LoadedNetworkBudgetTests.cpp \
+        OperationSupportCacheTests.cpp \
+        RequestQueueTests.cpp \
+        PendingRequestLimitTests.cpp \
+        PreparationPoolTests.cpp \
+        PrepareReportTests.cpp \
+        PreparedNetworkCacheTests.cpp \
+        ProgramCacheTests.cpp \
+        RequestSlotPoolTests.cpp \
+        RequestTimingsTests.cpp \
+        WarmUp.cpp \
         FullyConnected.cpp \
         GenericLayerTests.cpp \
         DriverTestHelpers.cpp \
         SystemProperties.cpp \
         Lstm.cpp \
         Merger.cpp \
-        TestTensor.cpp
+        TestTensor.cpp \
+        ThreadSchedulingTests.cpp
 
 LOCAL_STATIC_LIBRARIES := \
         libneuralnetworks_common \
@@ -147,6 +181,7 @@ LOCAL_WHOLE_STATIC_LIBRARIES := \
 
 LOCAL_SHARED_LIBRARIES := \
         libbase \
+        libcrypto \
         libhidlbase \
         libhidltransport \
         libhidlmemory \
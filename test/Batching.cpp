@@ -0,0 +1,113 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../RequestBatching.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+BOOST_AUTO_TEST_SUITE(BatchingTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+BOOST_AUTO_TEST_CASE(BatchableModels)
+{
+    V1_0::Model model = CreateFullyConnectedModel();
+    BOOST_TEST(IsModelBatchable(model));
+
+    const V1_0::Model batchedModel = CreateBatchedModel(model, 4);
+    BOOST_TEST(batchedModel.operands[0].dimensions[0] == 4);
+    BOOST_TEST(batchedModel.operands[4].dimensions[0] == 4);
+    // The constant weights and bias are left unchanged
+    BOOST_TEST(batchedModel.operands[1].dimensions[0] == 1);
+    BOOST_TEST(batchedModel.operands[2].dimensions[0] == 1);
+
+    // Models that already have a batch dimension are not batched
+    V1_0::Model multiBatchModel = model;
+    multiBatchModel.operands[0].dimensions = hidl_vec<uint32_t>{2, 3};
+    multiBatchModel.operands[4].dimensions = hidl_vec<uint32_t>{2, 1};
+    BOOST_TEST(!IsModelBatchable(multiBatchModel));
+
+    // Nor are models with operations that mix the elements of the batch
+    V1_0::Model reshapeModel = {};
+    AddInputOperand(reshapeModel, hidl_vec<uint32_t>{1, 4});
+    AddTensorOperand(reshapeModel, hidl_vec<uint32_t>{2}, std::vector<int32_t>{2, 2}, OperandType::TENSOR_INT32);
+    AddOutputOperand(reshapeModel, hidl_vec<uint32_t>{1, 2, 2});
+    reshapeModel.operations.resize(1);
+    reshapeModel.operations[0].type = V1_0::OperationType::RESHAPE;
+    reshapeModel.operations[0].inputs  = hidl_vec<uint32_t>{0, 1};
+    reshapeModel.operations[0].outputs = hidl_vec<uint32_t>{2};
+    BOOST_TEST(!IsModelBatchable(reshapeModel));
+}
+
+// Requests submitted together to a batching driver must each get their own results
+BOOST_AUTO_TEST_CASE(BatchedExecute)
+{
+    ALOGI("BatchedExecute: entry");
+
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({
+        "--compute", "CpuRef",
+        "--max-batch-size", "4",
+        "--max-batch-wait-us", "20000" }));
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(), *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 3 * sizeof(float);
+    RequestArgument input = {};
+    input.location = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 1 * sizeof(float);
+    RequestArgument output = {};
+    output.location  = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    // More requests than the batch size, so that both full and partial batches are executed
+    const size_t numRequests = 10;
+    std::vector<Request> requests(numRequests);
+    std::vector<android::sp<IMemory>> outMemory(numRequests);
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        requests[i].inputs  = hidl_vec<RequestArgument>{input};
+        requests[i].outputs = hidl_vec<RequestArgument>{output};
+        float indata[] = {static_cast<float>(i), 1, 2};
+        AddPoolAndSetData(3, requests[i], indata);
+        outMemory[i] = AddPoolAndGetData(1, requests[i]);
+    }
+
+    std::vector<android::sp<ExecutionCallback>> callbacks(numRequests);
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        callbacks[i] = ExecuteNoWait(preparedModel, requests[i]);
+    }
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        callbacks[i]->wait();
+    }
+
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        const float* outdata = static_cast<float*>(static_cast<void*>(outMemory[i]->getPointer()));
+        BOOST_TEST(outdata[0] == 2.0f * i + 10.0f);
+    }
+
+    // A request on its own is executed without waiting for a batch to fill, as the model was prepared
+    // for fast single answers
+    BOOST_TEST(Execute(preparedModel, requests[3]) == ErrorStatus::NONE);
+
+    ALOGI("BatchedExecute: exit");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
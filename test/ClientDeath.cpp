@@ -0,0 +1,151 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ArmnnPreparedModel.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(ClientDeathTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+// Large enough for the requests to pile up in the queue on CpuRef
+const uint32_t g_NumUnits = 512;
+
+// Counts the requests that completed
+class CountingExecutionCallback : public ExecutionCallback
+{
+public:
+    CountingExecutionCallback(std::atomic<unsigned int>& numNotified) : m_NumNotified(numNotified) {}
+
+    Return<void> notify(ErrorStatus status) override
+    {
+        ++m_NumNotified;
+        return ExecutionCallback::notify(status);
+    }
+
+private:
+    std::atomic<unsigned int>& m_NumNotified;
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(QueuedRequestsOfDeadClientAreDropped)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+    auto armnnPreparedModel = static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get());
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    const std::vector<float> indata(g_NumUnits, 1.0f);
+    AddPoolAndSetData(g_NumUnits, request, indata.data());
+    android::sp<IMemory> outMemory = AddPoolAndGetData(g_NumUnits, request);
+
+    // Queue requests, then simulate the death of the client while most of them are still queued
+    const unsigned int numRequests = 32;
+    std::atomic<unsigned int> numNotified(0);
+    for (unsigned int i = 0; i < numRequests; ++i)
+    {
+        android::sp<ExecutionCallback> callback = new CountingExecutionCallback(numNotified);
+        BOOST_TEST(preparedModel->execute(request, callback) == ErrorStatus::NONE);
+    }
+    armnnPreparedModel->HandleClientDeath();
+
+    // The requests still queued are dropped without being notified, so wait for the queue to drain
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (numNotified.load() + armnnPreparedModel->GetNumDroppedRequests() < numRequests &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Every client request was either executed before the death, or dropped without being notified
+    const std::size_t numDropped = armnnPreparedModel->GetNumDroppedRequests();
+    BOOST_TEST_MESSAGE("Dropped " << numDropped << " of " << numRequests << " queued requests");
+    BOOST_TEST(numDropped > 0);
+    BOOST_TEST(numNotified.load() + numDropped == numRequests);
+}
+
+// The client releases the model when it dies, while the request thread may still hold its queued requests
+BOOST_AUTO_TEST_CASE(ModelReleasedWithQueuedRequests)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    const std::vector<float> indata(g_NumUnits, 1.0f);
+    AddPoolAndSetData(g_NumUnits, request, indata.data());
+    android::sp<IMemory> outMemory = AddPoolAndGetData(g_NumUnits, request);
+
+    const unsigned int numRequests = 32;
+    std::atomic<unsigned int> numNotified(0);
+    for (unsigned int i = 0; i < numRequests; ++i)
+    {
+        android::sp<ExecutionCallback> callback = new CountingExecutionCallback(numNotified);
+        BOOST_TEST(preparedModel->execute(request, callback) == ErrorStatus::NONE);
+    }
+    static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get())->HandleClientDeath();
+
+    // Releasing the model waits for the request thread to be done with its requests
+    preparedModel.clear();
+    BOOST_TEST(numNotified.load() <= numRequests);
+
+    // The request thread is still usable by the other models
+    android::sp<IPreparedModel> otherModel = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    BOOST_TEST((Execute(otherModel, request) == ErrorStatus::NONE));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,11 @@
 #include <boost/test/unit_test.hpp>
 #include <log/log.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 BOOST_AUTO_TEST_SUITE(ConcurrentDriverTests)
 
 using ArmnnDriver = armnn_driver::ArmnnDriver;
@@ -15,6 +20,85 @@ using namespace android::hardware;
 using namespace driverTestHelpers;
 using namespace armnn_driver;
 
+namespace
+{
+
+// Executes the same number of requests on several prepared models using a driver with the given number
+// of request threads, checks the results and returns the achieved throughput in requests per second.
+double MeasureThroughput(unsigned int numRequestThreads)
+{
+    const uint32_t numUnits          = 256;
+    const size_t   numModels         = 4;
+    const size_t   requestsPerModel  = 16;
+    const size_t   numRequests       = numModels * requestsPerModel;
+
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({
+        "--compute", "CpuRef",
+        "--request-threads", std::to_string(numRequestThreads) }));
+
+    // Distinct models, as identical models would share a network and be executed one request at a time.
+    // Each output element is the sum of the input elements plus the index of the model.
+    std::vector<android::sp<IPreparedModel>> preparedModels;
+    for (size_t i = 0; i < numModels; ++i)
+    {
+        const V1_0::Model model = CreateFullyConnectedModel(numUnits, 1.0f, static_cast<float>(i));
+        preparedModels.push_back(PrepareModel(model, *driver));
+    }
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = numUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = numUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location  = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    const std::vector<float> indata(numUnits, 1.0f);
+    std::vector<Request> requests(numRequests);
+    std::vector<android::sp<IMemory>> outMemory(numRequests);
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        requests[i].inputs  = hidl_vec<RequestArgument>{input};
+        requests[i].outputs = hidl_vec<RequestArgument>{output};
+        AddPoolAndSetData(numUnits, requests[i], indata.data());
+        outMemory[i] = AddPoolAndGetData(numUnits, requests[i]);
+    }
+
+    // Interleave the requests across the models, as independent clients would
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<android::sp<ExecutionCallback>> cb(numRequests);
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        cb[i] = ExecuteNoWait(preparedModels[i % numModels], requests[i]);
+    }
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        cb[i]->wait();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        const float* outdata = static_cast<float*>(static_cast<void*>(outMemory[i]->getPointer()));
+        const float expected = static_cast<float>(numUnits + i % numModels);
+        BOOST_TEST(outdata[0] == expected);
+        BOOST_TEST(outdata[numUnits - 1] == expected);
+    }
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(numRequests) / seconds;
+}
+
+} // anonymous namespace
+
 // Add our own test for concurrent execution
 // The main point of this test is to check that multiple requests can be
 // executed without waiting for the callback from previous execution.
@@ -108,4 +192,127 @@ BOOST_AUTO_TEST_CASE(ConcurrentExecute)
     ALOGI("ConcurrentExecute: exit");
 }
 
+// Checks that requests for different prepared models are spread across the request threads,
+// and reports how the throughput scales with the number of threads.
+// The timings are only reported, as they depend on the number of cores available to the test.
+BOOST_AUTO_TEST_CASE(ConcurrentExecuteAcrossModels)
+{
+    ALOGI("ConcurrentExecuteAcrossModels: entry");
+
+    const double singleThreadThroughput = MeasureThroughput(1);
+    const double multiThreadThroughput  = MeasureThroughput(4);
+
+    ALOGI("ConcurrentExecuteAcrossModels: %.1f requests/s with 1 thread, %.1f requests/s with 4 threads",
+          singleThreadThroughput, multiThreadThroughput);
+    BOOST_TEST_MESSAGE("Throughput with 1 request thread: " << singleThreadThroughput << " requests/s");
+    BOOST_TEST_MESSAGE("Throughput with 4 request threads: " << multiThreadThroughput << " requests/s");
+
+    ALOGI("ConcurrentExecuteAcrossModels: exit");
+}
+
+// Stresses the driver as the binder threadpool does: several threads prepare and release large models while
+// another thread executes requests on a model prepared beforehand. Checks that the requests keep completing,
+// with the right results, while models are being prepared, i.e. that preparing a model holds no lock needed
+// by execute, and that concurrent preparations and releases are safe.
+BOOST_AUTO_TEST_CASE(PrepareDoesNotBlockExecute)
+{
+    const uint32_t     smallNumUnits     = 16;
+    const uint32_t     largeNumUnits     = 1024;
+    const unsigned int numPrepareThreads = 3;
+    const unsigned int preparesPerThread = 4;
+
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    const V1_0::Model smallModel = CreateFullyConnectedModel(smallNumUnits, 1.0f, 0.0f);
+    android::sp<IPreparedModel> preparedModel = PrepareModel(smallModel, *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = smallNumUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = smallNumUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location  = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    const std::vector<float> indata(smallNumUnits, 1.0f);
+    AddPoolAndSetData(smallNumUnits, request, indata.data());
+    android::sp<IMemory> outMemory = AddPoolAndGetData(smallNumUnits, request);
+    float* outdata = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    // Boost.Test assertions are not thread-safe, so the preparing threads only count their failures
+    std::atomic<unsigned int> numPreparing(0);
+    std::atomic<unsigned int> numFailedPrepares(0);
+    std::atomic<unsigned int> numThreadsDone(0);
+    std::vector<std::thread> prepareThreads;
+    for (unsigned int t = 0; t < numPrepareThreads; ++t)
+    {
+        prepareThreads.emplace_back([&, t]()
+        {
+            for (unsigned int i = 0; i < preparesPerThread; ++i)
+            {
+                // Each model is different, so that none of them reuses the network of another one
+                const V1_0::Model largeModel =
+                    CreateFullyConnectedModel(largeNumUnits, 1.0f, static_cast<float>(t * preparesPerThread + i));
+                ++numPreparing;
+                android::sp<PreparedModelCallback> cb(new PreparedModelCallback());
+                driver->prepareModel(largeModel, cb);
+                cb->wait();
+                if (cb->GetErrorStatus() != ErrorStatus::NONE || cb->GetPreparedModel() == nullptr)
+                {
+                    ++numFailedPrepares;
+                }
+                --numPreparing;
+                // Releasing the prepared model unloads its network, concurrently with the other preparations
+            }
+            ++numThreadsDone;
+        });
+    }
+
+    // Execute requests until all the models are prepared, counting those completed during a preparation
+    unsigned int numExecuted = 0;
+    unsigned int numExecutedWhilePreparing = 0;
+    std::chrono::steady_clock::duration maxLatency(0);
+    do
+    {
+        const bool preparing = numPreparing.load() != 0;
+
+        outdata[0] = 0;
+        const auto start = std::chrono::steady_clock::now();
+        android::sp<ExecutionCallback> cb(new ExecutionCallback());
+        BOOST_TEST(preparedModel->execute(request, cb) == ErrorStatus::NONE);
+        cb->wait();
+        maxLatency = std::max(maxLatency, std::chrono::steady_clock::now() - start);
+
+        BOOST_TEST(outdata[0] == static_cast<float>(smallNumUnits));
+        ++numExecuted;
+        if (preparing && numPreparing.load() != 0)
+        {
+            ++numExecutedWhilePreparing;
+        }
+    }
+    while (numThreadsDone.load() != numPrepareThreads);
+    for (std::thread& thread : prepareThreads)
+    {
+        thread.join();
+    }
+
+    BOOST_TEST(numFailedPrepares.load() == 0);
+    BOOST_TEST(numExecutedWhilePreparing > 0);
+    BOOST_TEST_MESSAGE("Executed " << numExecuted << " requests, " << numExecutedWhilePreparing
+                       << " while preparing models, max latency "
+                       << std::chrono::duration_cast<std::chrono::microseconds>(maxLatency).count() << "us");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
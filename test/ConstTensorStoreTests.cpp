@@ -0,0 +1,107 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "../ConstTensorStore.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ConstTensorStoreTests)
+
+using namespace armnn_driver;
+
+namespace
+{
+
+const armnn::PermutationVector g_NHWCToArmNN({ 0U, 2U, 3U, 1U });
+
+const armnn::TensorInfo g_TensorInfo(armnn::TensorShape({ 1, 2, 2, 3 }), armnn::DataType::Float32);
+
+std::vector<float> CreateValues(float first)
+{
+    std::vector<float> values(g_TensorInfo.GetNumElements());
+    for (unsigned int i = 0; i < values.size(); ++i)
+    {
+        values[i] = first + static_cast<float>(i);
+    }
+    return values;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(IdenticalTensorsAreStoredOnce)
+{
+    ConstTensorStore store;
+    const std::vector<float> values = CreateValues(1.0f);
+    const std::vector<float> sameValues = CreateValues(1.0f);
+
+    ConstTensorStore::Values first = store.GetPermuted(g_TensorInfo, values.data(), g_NHWCToArmNN);
+    ConstTensorStore::Values second = store.GetPermuted(g_TensorInfo, sameValues.data(), g_NHWCToArmNN);
+
+    BOOST_TEST(first.get() == second.get());
+    BOOST_TEST(store.GetNumStoredBytes() == g_TensorInfo.GetNumBytes());
+    BOOST_TEST(store.GetNumReusedPermutedBytes() == g_TensorInfo.GetNumBytes());
+
+    // The values are permuted from NHWC to NCHW
+    const float* permuted = reinterpret_cast<const float*>(first->data());
+    BOOST_TEST(permuted[0] == 1.0f);
+    BOOST_TEST(permuted[1] == 4.0f);
+    BOOST_TEST(permuted[4] == 2.0f);
+}
+
+BOOST_AUTO_TEST_CASE(DifferentTensorsAreStoredSeparately)
+{
+    ConstTensorStore store;
+    const std::vector<float> values = CreateValues(1.0f);
+    const std::vector<float> otherValues = CreateValues(2.0f);
+
+    ConstTensorStore::Values first = store.GetPermuted(g_TensorInfo, values.data(), g_NHWCToArmNN);
+    ConstTensorStore::Values other = store.GetPermuted(g_TensorInfo, otherValues.data(), g_NHWCToArmNN);
+    ConstTensorStore::Values otherPermutation =
+        store.GetPermuted(g_TensorInfo, values.data(), armnn::PermutationVector({ 0U, 3U, 2U, 1U }));
+
+    BOOST_TEST(first.get() != other.get());
+    BOOST_TEST(first.get() != otherPermutation.get());
+    BOOST_TEST(store.GetNumStoredBytes() == 3 * g_TensorInfo.GetNumBytes());
+    BOOST_TEST(store.GetNumReusedPermutedBytes() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ValuesAreReleasedWithTheirLastUser)
+{
+    ConstTensorStore store;
+    const std::vector<float> values = CreateValues(1.0f);
+
+    ConstTensorStore::Values first = store.GetPermuted(g_TensorInfo, values.data(), g_NHWCToArmNN);
+    first.reset();
+    BOOST_TEST(store.GetNumStoredBytes() == 0);
+
+    // Permuted again rather than shared
+    ConstTensorStore::Values second = store.GetPermuted(g_TensorInfo, values.data(), g_NHWCToArmNN);
+    BOOST_TEST(store.GetNumStoredBytes() == g_TensorInfo.GetNumBytes());
+    BOOST_TEST(store.GetNumReusedPermutedBytes() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ReleasedValuesArePruned)
+{
+    ConstTensorStore store;
+
+    // Converting many different tensors released right away does not grow the store
+    ConstTensorStore::Values kept = store.GetPermuted(g_TensorInfo, CreateValues(0.0f).data(), g_NHWCToArmNN);
+    std::size_t maxNumEntries = 0;
+    for (unsigned int i = 1; i <= 1000; ++i)
+    {
+        const std::vector<float> values = CreateValues(static_cast<float>(i));
+        store.GetPermuted(g_TensorInfo, values.data(), g_NHWCToArmNN);
+        maxNumEntries = std::max(maxNumEntries, store.GetNumEntries());
+    }
+    BOOST_TEST(maxNumEntries < 100);
+
+    // The values still used are kept
+    BOOST_TEST(store.GetPermuted(g_TensorInfo, CreateValues(0.0f).data(), g_NHWCToArmNN).get() == kept.get());
+    BOOST_TEST(store.GetNumStoredBytes() == g_TensorInfo.GetNumBytes());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
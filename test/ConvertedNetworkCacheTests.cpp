@@ -0,0 +1,134 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ConvertedNetworkCache.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include <chrono>
+
+BOOST_AUTO_TEST_SUITE(ConvertedNetworkCacheTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+ModelHash MakeHash(uint8_t value)
+{
+    ModelHash hash;
+    hash.fill(value);
+    return hash;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(TakeRemovesTheNetwork)
+{
+    ConvertedNetworkCache cache(2, std::chrono::seconds(60));
+    BOOST_TEST(cache.IsEnabled());
+
+    cache.Insert(MakeHash(1), armnn::INetwork::Create());
+    BOOST_TEST(cache.GetSize() == 1);
+
+    BOOST_TEST(!cache.Take(MakeHash(2)));
+    BOOST_TEST(static_cast<bool>(cache.Take(MakeHash(1))));
+    BOOST_TEST(!cache.Take(MakeHash(1)));
+    BOOST_TEST(cache.GetSize() == 0);
+    BOOST_TEST(cache.GetNumHits() == 1);
+    BOOST_TEST(cache.GetNumMisses() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(OldestNetworkIsDroppedWhenFull)
+{
+    ConvertedNetworkCache cache(2, std::chrono::seconds(60));
+
+    cache.Insert(MakeHash(1), armnn::INetwork::Create());
+    cache.Insert(MakeHash(2), armnn::INetwork::Create());
+    cache.Insert(MakeHash(3), armnn::INetwork::Create());
+    BOOST_TEST(cache.GetSize() == 2);
+
+    BOOST_TEST(!cache.Take(MakeHash(1)));
+    BOOST_TEST(static_cast<bool>(cache.Take(MakeHash(2))));
+    BOOST_TEST(static_cast<bool>(cache.Take(MakeHash(3))));
+}
+
+BOOST_AUTO_TEST_CASE(ExpiredNetworkIsDropped)
+{
+    ConvertedNetworkCache cache(2, std::chrono::seconds(0));
+
+    cache.Insert(MakeHash(1), armnn::INetwork::Create());
+    BOOST_TEST(!cache.Take(MakeHash(1)));
+    BOOST_TEST(cache.GetSize() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroCapacityDisablesTheCache)
+{
+    ConvertedNetworkCache cache(0, std::chrono::seconds(60));
+    BOOST_TEST(!cache.IsEnabled());
+
+    cache.Insert(MakeHash(1), armnn::INetwork::Create());
+    BOOST_TEST(cache.GetSize() == 0);
+    BOOST_TEST(!cache.Take(MakeHash(1)));
+}
+
+// The network converted when querying the supported operations is prepared once the model is released,
+// so it must not refer to the memory of the model
+BOOST_AUTO_TEST_CASE(NetworkConvertedBySupportQueryExecutesCorrectly)
+{
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({ "--compute", "CpuRef",
+                                                                     "--converted-network-cache-size", "2" }));
+
+    android::sp<IPreparedModel> preparedModel;
+    {
+        V1_0::Model model = CreateFullyConnectedModel();
+
+        ErrorStatus error;
+        std::vector<bool> supported;
+        ArmnnDriver::getSupportedOperations_cb cb = [&](ErrorStatus status, const std::vector<bool>& _supported)
+        {
+            error = status;
+            supported = _supported;
+        };
+        driver->getSupportedOperations(model, cb);
+        BOOST_TEST((int)error == (int)ErrorStatus::NONE);
+        BOOST_TEST(supported.size() == 1);
+        BOOST_TEST(supported[0] == true);
+
+        preparedModel = PrepareModel(CreateFullyConnectedModel(), *driver);
+    }
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 3 * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 1 * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    float indata[] = {2, 32, 16};
+    AddPoolAndSetData(3, request, indata);
+    android::sp<IMemory> outMemory = AddPoolAndGetData(1, request);
+
+    Execute(preparedModel, request);
+    BOOST_TEST(static_cast<float*>(static_cast<void*>(outMemory->getPointer()))[0] == 152);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
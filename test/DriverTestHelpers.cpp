@@ -6,6 +6,35 @@
 #include <log/log.h>
 #include <boost/test/unit_test.hpp>
 
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+// The number of heap allocations made by each thread, see ScopedAllocationCounter
+thread_local std::size_t g_NumThreadAllocations = 0;
+
+} // anonymous namespace
+
+// Replaces the global allocation functions of the test binary to count the allocations. The other forms of
+// operator new and delete, e.g. for arrays, call these.
+void* operator new(std::size_t size)
+{
+    ++g_NumThreadAllocations;
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
 namespace android
 {
 namespace hardware
@@ -56,11 +85,42 @@ Return<void> ExecutionCallback::wait()
 Return<void> PreparedModelCallback::notify(ErrorStatus status,
                                            const android::sp<IPreparedModel>& preparedModel)
 {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     m_ErrorStatus = status;
     m_PreparedModel = preparedModel;
+    m_Notified = true;
+    m_Condition.notify_one();
     return Void();
 }
 
+Return<void> PreparedModelCallback::wait()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait(lock, [this] { return m_Notified; });
+    return Void();
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter()
+    : m_Start(g_NumThreadAllocations)
+{
+}
+
+std::size_t ScopedAllocationCounter::GetNumAllocations() const
+{
+    return g_NumThreadAllocations - m_Start;
+}
+
+DriverOptions CreateDriverOptions(std::vector<std::string> arguments)
+{
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>("armnn-driver-tests"));
+    for (std::string& argument : arguments)
+    {
+        argv.push_back(&argument[0]);
+    }
+    return DriverOptions(static_cast<int>(argv.size()), argv.data());
+}
+
 // lifted from common/Utils.cpp
 hidl_memory allocateSharedMemory(int64_t size)
 {
@@ -109,6 +169,40 @@ void AddPoolAndSetData(uint32_t size, Request& request, const float* data)
     memcpy(dst, data, size * sizeof(float));
 }
 
+V1_0::Model CreateFullyConnectedModel(const std::vector<float>& weights,
+                                      const std::vector<float>& bias,
+                                      int32_t activation)
+{
+    const uint32_t numUnits  = static_cast<uint32_t>(bias.size());
+    const uint32_t numInputs = static_cast<uint32_t>(weights.size()) / numUnits;
+
+    V1_0::Model model = {};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, numInputs});
+    AddTensorOperand(model, hidl_vec<uint32_t>{numUnits, numInputs}, weights);
+    AddTensorOperand(model, hidl_vec<uint32_t>{numUnits}, bias);
+    AddIntOperand(model, activation);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, numUnits});
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    return model;
+}
+
+V1_0::Model CreateFullyConnectedModel()
+{
+    return CreateFullyConnectedModel(std::vector<float>{2, 4, 1}, std::vector<float>{4});
+}
+
+V1_0::Model CreateFullyConnectedModel(uint32_t numUnits, float weight, float bias)
+{
+    return CreateFullyConnectedModel(std::vector<float>(numUnits * numUnits, weight),
+                                     std::vector<float>(numUnits, bias));
+}
+
 android::sp<IPreparedModel> PrepareModelWithStatus(const V1_0::Model& model,
                                                    armnn_driver::ArmnnDriver& driver,
                                                    ErrorStatus& prepareStatus,
@@ -116,6 +210,7 @@ android::sp<IPreparedModel> PrepareModelWithStatus(const V1_0::Model& model,
 {
     android::sp<PreparedModelCallback> cb(new PreparedModelCallback());
     driver.prepareModel(model, cb);
+    cb->wait();
 
     prepareStatus = cb->GetErrorStatus();
     BOOST_TEST(prepareStatus == expectedStatus);
@@ -135,6 +230,7 @@ android::sp<IPreparedModel> PrepareModelWithStatus(const V1_1::Model& model,
 {
     android::sp<PreparedModelCallback> cb(new PreparedModelCallback());
     driver.prepareModel_1_1(model, V1_1::ExecutionPreference::LOW_POWER, cb);
+    cb->wait();
 
     prepareStatus = cb->GetErrorStatus();
     BOOST_TEST(prepareStatus == expectedStatus);
@@ -10,6 +10,8 @@
 
 #include "../ArmnnDriver.hpp"
 #include <iosfwd>
+#include <string>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 
 namespace android
@@ -54,19 +56,41 @@ public:
     PreparedModelCallback()
         : m_ErrorStatus(ErrorStatus::NONE)
         , m_PreparedModel()
+        , m_Notified(false)
     { }
     ~PreparedModelCallback() override { }
 
     Return<void> notify(ErrorStatus status,
                         const android::sp<IPreparedModel>& preparedModel) override;
+    /// wait until the driver has notified us that the model is prepared, as it is prepared asynchronously
+    Return<void> wait();
     ErrorStatus GetErrorStatus() { return m_ErrorStatus; }
     android::sp<IPreparedModel> GetPreparedModel() { return m_PreparedModel; }
 
 private:
     ErrorStatus                  m_ErrorStatus;
     android::sp<IPreparedModel>  m_PreparedModel;
+    std::mutex                   m_Mutex;
+    std::condition_variable      m_Condition;
+    bool                         m_Notified;
+};
+
+/// Counts the heap allocations made with operator new by the calling thread since the counter was created,
+/// e.g. to check that a call does not allocate. The allocations made by other threads are not counted.
+class ScopedAllocationCounter
+{
+public:
+    ScopedAllocationCounter();
+
+    std::size_t GetNumAllocations() const;
+
+private:
+    const std::size_t m_Start;
 };
 
+/// Creates driver options by parsing the given command line arguments, as the driver service does
+armnn_driver::DriverOptions CreateDriverOptions(std::vector<std::string> arguments);
+
 hidl_memory allocateSharedMemory(int64_t size);
 
 android::sp<IMemory> AddPoolAndGetData(uint32_t size, Request& request);
@@ -182,6 +206,19 @@ void AddOutputOperand(HalModel& model,
     model.outputIndexes[model.outputIndexes.size() - 1] = model.operands.size() - 1;
 }
 
+/// Creates a model made of a single fully connected layer, with as many outputs as biases.
+/// The weights hold one row per output, of as many weights as the layer has inputs.
+V1_0::Model CreateFullyConnectedModel(const std::vector<float>& weights,
+                                      const std::vector<float>& bias,
+                                      int32_t activation = 0);
+
+/// Creates a fully connected model computing 2 * in[0] + 4 * in[1] + in[2] + 4
+V1_0::Model CreateFullyConnectedModel();
+
+/// Creates a fully connected model with numUnits inputs and outputs, all its weights and biases set to the given
+/// values, so that each output is the sum of the inputs times weight, plus bias
+V1_0::Model CreateFullyConnectedModel(uint32_t numUnits, float weight, float bias = 1.0f);
+
 android::sp<IPreparedModel> PrepareModelWithStatus(const V1_0::Model& model,
                                                    armnn_driver::ArmnnDriver& driver,
                                                    ErrorStatus& prepareStatus,
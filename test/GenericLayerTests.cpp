@@ -212,6 +212,69 @@ BOOST_AUTO_TEST_CASE(UnsupportedLayerContinueOnFailure)
     BOOST_TEST(supported[2] == false);
 }
 
+// When the converted networks are not kept for prepareModel, the supported operations are found with a dry run that
+// does not copy the constant tensors. The layers using them are still checked for support.
+BOOST_AUTO_TEST_CASE(DryRunFindsSupportedOperations)
+{
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({ "--compute", "CpuRef",
+                                                                     "--converted-network-cache-size", "0" }));
+
+    ErrorStatus errorStatus;
+    std::vector<bool> supported;
+
+    auto cb = [&](ErrorStatus _errorStatus, const std::vector<bool>& _supported)
+    {
+        errorStatus = _errorStatus;
+        supported = _supported;
+    };
+
+    V1_0::Model model = {};
+
+    // Fully connected with a fused ReLu activation
+    int32_t reluValue     = 1;
+    int32_t actValue      = 0;
+    float   weightValue[] = {2, 4, 1};
+    float   biasValue[]   = {4};
+    float   addendValue[] = {1};
+
+    AddInputOperand (model, hidl_vec<uint32_t>{1, 3});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 3}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue);
+    AddIntOperand   (model, reluValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1});
+
+    // Addition of a constant to the output of the fully connected operation
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, addendValue);
+    AddIntOperand   (model, actValue);
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1});
+
+    // EMBEDDING_LOOKUP is unsupported
+    AddInputOperand (model, hidl_vec<uint32_t>{1}, V1_0::OperandType::TENSOR_INT32);
+    AddInputOperand (model, hidl_vec<uint32_t>{1, 1, 3, 4});
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1, 3, 4});
+
+    model.operations.resize(3);
+
+    model.operations[0].type    = V1_0::OperationType::FULLY_CONNECTED;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3};
+    model.operations[0].outputs = hidl_vec<uint32_t>{4};
+
+    model.operations[1].type    = V1_0::OperationType::ADD;
+    model.operations[1].inputs  = hidl_vec<uint32_t>{4, 5, 6};
+    model.operations[1].outputs = hidl_vec<uint32_t>{7};
+
+    model.operations[2].type    = V1_0::OperationType::EMBEDDING_LOOKUP;
+    model.operations[2].inputs  = hidl_vec<uint32_t>{8, 9};
+    model.operations[2].outputs = hidl_vec<uint32_t>{10};
+
+    driver->getSupportedOperations(model, cb);
+    BOOST_TEST((int)errorStatus == (int)ErrorStatus::NONE);
+    BOOST_TEST(supported.size() == (size_t)3);
+    BOOST_TEST(supported[0] == true);
+    BOOST_TEST(supported[1] == true);
+    BOOST_TEST(supported[2] == false);
+}
+
 // The purpose of this test is to ensure that when encountering an failure
 // during mem pool mapping we properly report an error to the framework via a callback
 BOOST_AUTO_TEST_CASE(ModelToINetworkConverterMemPoolFail)
@@ -0,0 +1,109 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ArmnnPreparedModel.hpp"
+#include "../LoadedNetworkBudget.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+BOOST_AUTO_TEST_SUITE(LoadedNetworkBudgetTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+// The weights of the models take 1 MB
+const uint32_t g_NumUnits = 512;
+
+float ExecuteAndGetFirstOutput(const android::sp<IPreparedModel>& preparedModel)
+{
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    const std::vector<float> indata(g_NumUnits, 1.0f);
+    AddPoolAndSetData(g_NumUnits, request, indata.data());
+    android::sp<IMemory> outMemory = AddPoolAndGetData(g_NumUnits, request);
+
+    Execute(preparedModel, request);
+    return static_cast<float*>(static_cast<void*>(outMemory->getPointer()))[0];
+}
+
+const SharedNetwork& GetNetwork(const android::sp<IPreparedModel>& preparedModel)
+{
+    return static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get())->GetNetwork();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(LeastRecentlyUsedNetworkIsReloadedOnExecute)
+{
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({ "--compute", "CpuRef",
+                                                                     "--loaded-networks-budget-mb", "1" }));
+
+    // Each network exceeds the budget on its own, so loading one unloads the other
+    android::sp<IPreparedModel> first  = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    android::sp<IPreparedModel> second = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.25f), *driver);
+    const LoadedNetworkBudget& budget = GetNetwork(first).GetBudget();
+    BOOST_TEST(budget.IsEnabled());
+    BOOST_TEST(!GetNetwork(first).IsLoaded());
+    BOOST_TEST(GetNetwork(second).IsLoaded());
+    BOOST_TEST(budget.GetNumLoadedNetworks() == 1);
+    BOOST_TEST(budget.GetNumEvictions() == 1);
+    BOOST_TEST(budget.GetNumReloads() == 0);
+
+    // Executing the unloaded model loads its network again transparently
+    BOOST_TEST(ExecuteAndGetFirstOutput(first) == 0.5f * g_NumUnits + 1.0f);
+    BOOST_TEST(GetNetwork(first).IsLoaded());
+    BOOST_TEST(!GetNetwork(second).IsLoaded());
+    BOOST_TEST(budget.GetNumEvictions() == 2);
+    BOOST_TEST(budget.GetNumReloads() == 1);
+
+    BOOST_TEST(ExecuteAndGetFirstOutput(second) == 0.25f * g_NumUnits + 1.0f);
+    BOOST_TEST(ExecuteAndGetFirstOutput(second) == 0.25f * g_NumUnits + 1.0f);
+    BOOST_TEST(budget.GetNumReloads() == 2);
+    BOOST_TEST_MESSAGE("Loading the networks again took " << budget.GetTotalReloadTime().count() << "us in total");
+
+    // Released networks no longer count against the budget
+    first.clear();
+    second.clear();
+    BOOST_TEST(budget.GetNumLoadedNetworks() == 0);
+    BOOST_TEST(budget.GetLoadedBytes() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(NetworksStayLoadedWithoutBudget)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    android::sp<IPreparedModel> first  = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    android::sp<IPreparedModel> second = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.25f), *driver);
+    BOOST_TEST(!GetNetwork(first).GetBudget().IsEnabled());
+    BOOST_TEST(GetNetwork(first).IsLoaded());
+    BOOST_TEST(GetNetwork(second).IsLoaded());
+    BOOST_TEST(GetNetwork(first).GetBudget().GetNumEvictions() == 0);
+    BOOST_TEST(ExecuteAndGetFirstOutput(first) == 0.5f * g_NumUnits + 1.0f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ModelHash.hpp"
+#include "../OperationSupportCache.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+BOOST_AUTO_TEST_SUITE(OperationSupportCacheTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+ModelHash MakeHash(uint8_t value)
+{
+    ModelHash hash;
+    hash.fill(value);
+    return hash;
+}
+
+// A fully connected model with a single output
+V1_0::Model CreateSingleOutputModel(uint32_t numInputs, float weight, int32_t activation)
+{
+    return CreateFullyConnectedModel(std::vector<float>(numInputs, weight), std::vector<float>{1}, activation);
+}
+
+ModelHash HashSignature(const V1_0::Model& model)
+{
+    // The test models only have constant copies
+    ModelHasher hasher;
+    AddOperationSignatureToHash(model, 0, std::vector<android::nn::RunTimePoolInfo>(), hasher);
+    return hasher.GetHash();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SignatureIgnoresLargeWeights)
+{
+    const ModelHash signature = HashSignature(CreateSingleOutputModel(128, 0.5f, 0));
+
+    // The weights are 512 bytes, too large to be part of the signature
+    BOOST_TEST((HashSignature(CreateSingleOutputModel(128, 0.25f, 0)) == signature));
+
+    // Scalar parameters, small constant tensors and shapes are
+    BOOST_TEST((HashSignature(CreateSingleOutputModel(128, 0.5f, 1)) != signature));
+    BOOST_TEST((HashSignature(CreateSingleOutputModel(4, 0.5f, 0)) !=
+                HashSignature(CreateSingleOutputModel(4, 0.25f, 0))));
+    BOOST_TEST((HashSignature(CreateSingleOutputModel(64, 0.5f, 0)) != signature));
+}
+
+BOOST_AUTO_TEST_CASE(LeastRecentlyUsedEntryIsDropped)
+{
+    OperationSupportCache cache(2);
+    bool isSupported = false;
+
+    cache.Insert(MakeHash(1), true);
+    cache.Insert(MakeHash(2), false);
+    BOOST_TEST(cache.Find(MakeHash(1), isSupported));
+    BOOST_TEST(isSupported);
+
+    // The second entry is now the least recently used one
+    cache.Insert(MakeHash(3), true);
+    BOOST_TEST(cache.GetSize() == 2);
+    BOOST_TEST(!cache.Find(MakeHash(2), isSupported));
+    BOOST_TEST(cache.Find(MakeHash(1), isSupported));
+    BOOST_TEST(cache.Find(MakeHash(3), isSupported));
+
+    BOOST_TEST(cache.GetNumHits() == 3);
+    BOOST_TEST(cache.GetNumMisses() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroCapacityKeepsNothing)
+{
+    OperationSupportCache cache(0);
+    bool isSupported = false;
+
+    cache.Insert(MakeHash(1), true);
+    BOOST_TEST(cache.GetSize() == 0);
+    BOOST_TEST(!cache.Find(MakeHash(1), isSupported));
+}
+
+// The support queries of models sharing operation signatures are answered from the cache
+BOOST_AUTO_TEST_CASE(RepeatedSignatureIsNotConvertedAgain)
+{
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({ "--compute", "CpuRef",
+                                                                     "--converted-network-cache-size", "0" }));
+
+    ErrorStatus errorStatus;
+    std::vector<bool> supported;
+    auto cb = [&](ErrorStatus _errorStatus, const std::vector<bool>& _supported)
+    {
+        errorStatus = _errorStatus;
+        supported = _supported;
+    };
+
+    // Other tests may have converted the same operation before
+    driver->getSupportedOperations(CreateSingleOutputModel(100, 0.5f, 0), cb);
+    BOOST_TEST((int)errorStatus == (int)ErrorStatus::NONE);
+    BOOST_TEST(supported.size() == 1);
+    BOOST_TEST(supported[0] == true);
+
+    const std::size_t numHits = GetOperationSupportCache().GetNumHits();
+    driver->getSupportedOperations(CreateSingleOutputModel(100, 0.25f, 0), cb);
+    BOOST_TEST((int)errorStatus == (int)ErrorStatus::NONE);
+    BOOST_TEST(supported.size() == 1);
+    BOOST_TEST(supported[0] == true);
+    BOOST_TEST(GetOperationSupportCache().GetNumHits() == numHits + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
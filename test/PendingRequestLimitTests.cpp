@@ -0,0 +1,152 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ArmnnPreparedModel.hpp"
+#include "../PendingRequestLimit.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include <future>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(PendingRequestLimitTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+// Large enough for the requests to pile up in the queue on CpuRef
+const uint32_t g_NumUnits = 512;
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(RejectsWhenFull)
+{
+    PendingRequestLimit limit(2);
+    const PendingRequestLimit::Clock::time_point now = PendingRequestLimit::Clock::now();
+
+    BOOST_TEST(limit.Acquire(now));
+    BOOST_TEST(limit.Acquire(now));
+    BOOST_TEST(limit.GetNumPendingRequests() == 2);
+    BOOST_TEST(!limit.Acquire(now));
+    BOOST_TEST(limit.GetNumPendingRequests() == 2);
+
+    limit.Release();
+    BOOST_TEST(limit.Acquire(now));
+    limit.Release();
+    limit.Release();
+    BOOST_TEST(limit.GetNumPendingRequests() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(WaitsUntilDeadline)
+{
+    PendingRequestLimit limit(1);
+    BOOST_TEST(limit.Acquire(PendingRequestLimit::Clock::now()));
+
+    const PendingRequestLimit::Clock::time_point start = PendingRequestLimit::Clock::now();
+    BOOST_TEST(!limit.Acquire(start + std::chrono::milliseconds(20)));
+    BOOST_TEST((PendingRequestLimit::Clock::now() - start >= std::chrono::milliseconds(20)));
+
+    limit.Release();
+}
+
+BOOST_AUTO_TEST_CASE(ReleaseWakesWaiter)
+{
+    PendingRequestLimit limit(1);
+    BOOST_TEST(limit.Acquire(PendingRequestLimit::Clock::now()));
+
+    std::future<bool> waiter = std::async(std::launch::async, [&limit]()
+    {
+        return limit.Acquire(PendingRequestLimit::Clock::now() + std::chrono::seconds(10));
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    limit.Release();
+    BOOST_TEST(waiter.get());
+    BOOST_TEST(limit.GetNumPendingRequests() == 1);
+
+    limit.Release();
+}
+
+BOOST_AUTO_TEST_CASE(ZeroMeansNoLimit)
+{
+    PendingRequestLimit limit(0);
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        BOOST_TEST(limit.Acquire(PendingRequestLimit::Clock::now()));
+    }
+    BOOST_TEST(limit.GetNumPendingRequests() == 1000);
+}
+
+BOOST_AUTO_TEST_CASE(BurstIsRejectedOverLimit)
+{
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({
+        "--compute", "CpuRef",
+        "--max-pending-requests-per-model", "2" }));
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+    auto armnnPreparedModel = static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get());
+    BOOST_TEST(armnnPreparedModel->GetPendingRequestLimit().GetMaxPendingRequests() == 2);
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    const std::vector<float> indata(g_NumUnits, 1.0f);
+    AddPoolAndSetData(g_NumUnits, request, indata.data());
+    AddPoolAndGetData(g_NumUnits, request);
+
+    // Submit a burst far larger than the limit, the requests over it are rejected rather than queued
+    const unsigned int numRequests = 32;
+    std::vector<android::sp<ExecutionCallback>> callbacks;
+    unsigned int numRejected = 0;
+    for (unsigned int i = 0; i < numRequests; ++i)
+    {
+        android::sp<ExecutionCallback> callback(new ExecutionCallback());
+        const ErrorStatus status = preparedModel->execute(request, callback);
+        if (status == ErrorStatus::NONE)
+        {
+            callbacks.push_back(callback);
+        }
+        else
+        {
+            BOOST_TEST(status == ErrorStatus::DEVICE_UNAVAILABLE);
+            ++numRejected;
+        }
+        BOOST_TEST(armnnPreparedModel->GetPendingRequestLimit().GetNumPendingRequests() <= 2);
+    }
+    BOOST_TEST_MESSAGE("Rejected " << numRejected << " of " << numRequests << " requests");
+    BOOST_TEST(numRejected > 0);
+
+    // The admitted requests all complete, after which the queue depth is back to 0
+    for (auto& callback : callbacks)
+    {
+        callback->wait();
+    }
+    BOOST_TEST(armnnPreparedModel->GetPendingRequestLimit().GetNumPendingRequests() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "../PreparationPool.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(PreparationPoolTests)
+
+using namespace armnn_driver;
+
+namespace
+{
+
+/// Blocks the tasks calling Wait until Open is called
+class Gate
+{
+public:
+    Gate() : m_Open(false) {}
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Cv.wait(lock, [this] { return m_Open; });
+    }
+
+    void Open()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Open = true;
+        m_Cv.notify_all();
+    }
+
+private:
+    std::mutex              m_Mutex;
+    std::condition_variable m_Cv;
+    bool                    m_Open;
+};
+
+bool WaitFor(const std::atomic<unsigned int>& value, unsigned int expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (value.load() != expected)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(TasksRunInParallelOffTheCallingThread)
+{
+    Gate gate;
+    std::atomic<unsigned int> numRunning(0);
+    std::atomic<unsigned int> numOnCallingThread(0);
+    const std::thread::id callingThread = std::this_thread::get_id();
+
+    {
+        PreparationPool pool(2, 0);
+        BOOST_TEST(pool.GetNumThreads() == 2);
+
+        // Post returns while the tasks are blocked, and both run at the same time
+        for (unsigned int i = 0; i < 2; ++i)
+        {
+            pool.Post([&]()
+            {
+                if (std::this_thread::get_id() == callingThread)
+                {
+                    ++numOnCallingThread;
+                }
+                ++numRunning;
+                gate.Wait();
+            });
+        }
+        BOOST_TEST(WaitFor(numRunning, 2));
+        gate.Open();
+    }
+
+    BOOST_TEST(numOnCallingThread.load() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(FullQueueRunsTasksInCallingThread)
+{
+    Gate gate;
+    std::atomic<unsigned int> numStarted(0);
+    std::atomic<unsigned int> numCompleted(0);
+    bool ranOnCallingThread = false;
+
+    {
+        PreparationPool pool(1, 1);
+
+        // The first task occupies the worker and the second one fills the queue
+        auto blockedTask = [&]()
+        {
+            ++numStarted;
+            gate.Wait();
+            ++numCompleted;
+        };
+        pool.Post(blockedTask);
+        BOOST_REQUIRE(WaitFor(numStarted, 1));
+        pool.Post(blockedTask);
+
+        const std::thread::id callingThread = std::this_thread::get_id();
+        pool.Post([&]() { ranOnCallingThread = std::this_thread::get_id() == callingThread; });
+        BOOST_TEST(ranOnCallingThread);
+
+        gate.Open();
+    }
+
+    // The queued task is completed before the pool is destroyed
+    BOOST_TEST(numCompleted.load() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(NoThreadsRunsTasksInCallingThread)
+{
+    PreparationPool pool(0, 0);
+    BOOST_TEST(pool.GetNumThreads() == 0);
+
+    bool ran = false;
+    pool.Post([&]() { ran = true; });
+    BOOST_TEST(ran);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ArmnnPreparedModel.hpp"
+#include "../PrepareReport.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#include <dirent.h>
+#include <unistd.h>
+
+BOOST_AUTO_TEST_SUITE(PrepareReportTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+/// Creates a dump directory for a test, deleted with its files at the end of the test
+class DumpDir
+{
+public:
+    DumpDir()
+    {
+        char path[] = "/data/local/tmp/armnn-prepare-XXXXXX";
+        BOOST_REQUIRE(mkdtemp(path) != nullptr);
+        m_Path = path;
+    }
+
+    ~DumpDir()
+    {
+        DIR* dir = opendir(m_Path.c_str());
+        if (dir != nullptr)
+        {
+            while (dirent* entry = readdir(dir))
+            {
+                if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+                {
+                    unlink((m_Path + "/" + entry->d_name).c_str());
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(m_Path.c_str());
+    }
+
+    const std::string& GetPath() const { return m_Path; }
+
+private:
+    std::string m_Path;
+};
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(PhasesAreTimed)
+{
+    PrepareReport report;
+
+    report.BeginPhase(PreparePhase::Optimize);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // Beginning a phase ends the previous one
+    report.BeginPhase(PreparePhase::LoadNetwork);
+    report.EndPhase();
+    report.AddOperation(0, "CONV_2D", std::chrono::milliseconds(2));
+
+    BOOST_TEST(report.GetDuration(PreparePhase::Optimize).count() >= 10000);
+    BOOST_TEST(report.GetDuration(PreparePhase::Optimize).count() <= report.GetTotalDuration().count());
+    BOOST_TEST(report.GetDuration(PreparePhase::WarmUp).count() == 0);
+
+    const std::string summary = report.GetSummary();
+    BOOST_TEST(summary.find("optimize") != std::string::npos);
+    BOOST_TEST(summary.find("load_network") != std::string::npos);
+    BOOST_TEST(summary.find("warm_up") == std::string::npos);
+    BOOST_TEST(summary.find("1 operations") != std::string::npos);
+
+    BOOST_TEST(GetResidentSetSizeKb() > 0);
+    BOOST_TEST(GetPeakResidentSetSizeKb() > 0);
+}
+
+BOOST_AUTO_TEST_CASE(PrepareWritesReport)
+{
+    DumpDir dumpDir;
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({ "--compute", "CpuRef",
+                                                                     "--request-inputs-and-outputs-dump-dir",
+                                                                     dumpDir.GetPath() }));
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(), *driver);
+    const armnn::NetworkId networkId =
+        static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get())->GetNetworkId();
+
+    // The report is written once the client is notified, destroying the driver waits for it
+    preparedModel.clear();
+    driver.reset();
+
+    std::ifstream fileStream(dumpDir.GetPath() + "/" + std::to_string(networkId) + "_prepare.json");
+    BOOST_REQUIRE(fileStream.good());
+    const std::string report((std::istreambuf_iterator<char>(fileStream)), std::istreambuf_iterator<char>());
+
+    BOOST_TEST(report.find("\"network_id\": " + std::to_string(networkId)) != std::string::npos);
+    for (const char* phase : { "map_pools", "convert_operations", "optimize", "load_network", "warm_up" })
+    {
+        BOOST_TEST(report.find(std::string("\"name\": \"") + phase + "\"") != std::string::npos);
+    }
+    BOOST_TEST(report.find("\"peak_rss_delta_kb\"") != std::string::npos);
+    BOOST_TEST(report.find("\"type\": \"FULLY_CONNECTED\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(ModelsSharingNetworkDumpSeparateFiles)
+{
+    DumpDir dumpDir;
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({ "--compute", "CpuRef",
+                                                                     "--request-inputs-and-outputs-dump-dir",
+                                                                     dumpDir.GetPath() }));
+
+    // The identical models share the network
+    android::sp<IPreparedModel> first  = PrepareModel(CreateFullyConnectedModel(), *driver);
+    android::sp<IPreparedModel> second = PrepareModel(CreateFullyConnectedModel(), *driver);
+    auto armnnFirst  = static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(first.get());
+    auto armnnSecond = static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(second.get());
+    BOOST_TEST(armnnFirst->GetNetworkId() == armnnSecond->GetNetworkId());
+    BOOST_TEST(armnnFirst->GetPreparedModelId() != armnnSecond->GetPreparedModelId());
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 3 * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 1 * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    float indata[] = {2, 32, 16};
+    AddPoolAndSetData(3, request, indata);
+    android::sp<IMemory> outMemory = AddPoolAndGetData(1, request);
+
+    Execute(first, request);
+    Execute(second, request);
+
+    std::vector<std::string> fileNames;
+    for (auto model : { armnnFirst, armnnSecond })
+    {
+        fileNames.push_back(dumpDir.GetPath() + "/" + std::to_string(model->GetNetworkId()) + "_" +
+                            std::to_string(model->GetPreparedModelId()) + "_latency.json");
+    }
+
+    // The latencies are written when the models are destroyed
+    first.clear();
+    second.clear();
+    driver.reset();
+
+    for (const std::string& fileName : fileNames)
+    {
+        std::ifstream fileStream(fileName);
+        BOOST_TEST(fileStream.good(), fileName);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ArmnnPreparedModel.hpp"
+#include "../ModelHash.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include <chrono>
+
+BOOST_AUTO_TEST_SUITE(PreparedNetworkCacheTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+const uint32_t g_NumUnits = 256;
+
+ModelHash HashModel(const V1_0::Model& model)
+{
+    ModelHasher hasher;
+    BOOST_TEST(AddModelToHash(model, hasher));
+    return hasher.GetHash();
+}
+
+float ExecuteAndGetFirstOutput(const android::sp<IPreparedModel>& preparedModel)
+{
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    const std::vector<float> indata(g_NumUnits, 1.0f);
+    AddPoolAndSetData(g_NumUnits, request, indata.data());
+    android::sp<IMemory> outMemory = AddPoolAndGetData(g_NumUnits, request);
+
+    Execute(preparedModel, request);
+    return static_cast<float*>(static_cast<void*>(outMemory->getPointer()))[0];
+}
+
+armnn::NetworkId GetNetworkId(const android::sp<IPreparedModel>& preparedModel)
+{
+    return static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get())->GetNetworkId();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(HashDependsOnContent)
+{
+    const V1_0::Model model = CreateFullyConnectedModel(g_NumUnits, 0.5f);
+    BOOST_TEST((HashModel(model) == HashModel(CreateFullyConnectedModel(g_NumUnits, 0.5f))));
+    BOOST_TEST((HashModel(model) != HashModel(CreateFullyConnectedModel(g_NumUnits, 0.25f))));
+
+    V1_0::Model otherShape = model;
+    otherShape.operands[0].dimensions = hidl_vec<uint32_t>{2, g_NumUnits};
+    BOOST_TEST((HashModel(model) != HashModel(otherShape)));
+
+    V1_0::Model otherOperation = model;
+    otherOperation.operations[0].type = V1_0::OperationType::ADD;
+    BOOST_TEST((HashModel(model) != HashModel(otherOperation)));
+
+    BOOST_TEST(ModelHashToString(HashModel(model)).size() == 64);
+}
+
+BOOST_AUTO_TEST_CASE(IdenticalModelsShareNetwork)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+
+    const auto missStart = std::chrono::steady_clock::now();
+    android::sp<IPreparedModel> first = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    const auto missEnd = std::chrono::steady_clock::now();
+    android::sp<IPreparedModel> second = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    const auto hitEnd = std::chrono::steady_clock::now();
+    android::sp<IPreparedModel> other = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.25f), *driver);
+
+    BOOST_TEST_MESSAGE("Preparing the model took "
+                       << std::chrono::duration_cast<std::chrono::microseconds>(missEnd - missStart).count()
+                       << "us, preparing it again took "
+                       << std::chrono::duration_cast<std::chrono::microseconds>(hitEnd - missEnd).count() << "us");
+
+    // The identical models share the network, which both execute correctly
+    BOOST_TEST(GetNetworkId(first) == GetNetworkId(second));
+    BOOST_TEST(GetNetworkId(first) != GetNetworkId(other));
+    BOOST_TEST(ExecuteAndGetFirstOutput(first) == 0.5f * g_NumUnits + 1.0f);
+    BOOST_TEST(ExecuteAndGetFirstOutput(second) == 0.5f * g_NumUnits + 1.0f);
+    BOOST_TEST(ExecuteAndGetFirstOutput(other) == 0.25f * g_NumUnits + 1.0f);
+
+    // The network stays loaded while a model uses it
+    const armnn::NetworkId sharedNetworkId = GetNetworkId(first);
+    first.clear();
+    BOOST_TEST(ExecuteAndGetFirstOutput(second) == 0.5f * g_NumUnits + 1.0f);
+
+    // Once released by every model, the network is unloaded and preparing the model loads a new one
+    second.clear();
+    android::sp<IPreparedModel> third = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+    BOOST_TEST(GetNetworkId(third) != sharedNetworkId);
+    BOOST_TEST(ExecuteAndGetFirstOutput(third) == 0.5f * g_NumUnits + 1.0f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
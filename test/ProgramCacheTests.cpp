@@ -0,0 +1,230 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../CacheFile.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+#include <OperationsUtils.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <dirent.h>
+#include <unistd.h>
+
+BOOST_AUTO_TEST_SUITE(ProgramCacheTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+/// A directory created for a test, deleted with its files at the end of the test
+class TempDir
+{
+public:
+    TempDir()
+    {
+        char path[] = "/data/local/tmp/armnn-cache-XXXXXX";
+        BOOST_REQUIRE(mkdtemp(path) != nullptr);
+        m_Path = path;
+    }
+
+    ~TempDir()
+    {
+        DIR* dir = opendir(m_Path.c_str());
+        if (dir != nullptr)
+        {
+            while (dirent* entry = readdir(dir))
+            {
+                if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+                {
+                    unlink((m_Path + "/" + entry->d_name).c_str());
+                }
+            }
+            closedir(dir);
+        }
+        rmdir(m_Path.c_str());
+    }
+
+    const std::string& GetPath() const { return m_Path; }
+
+private:
+    std::string m_Path;
+};
+
+bool FileExists(const std::string& path)
+{
+    return access(path.c_str(), F_OK) == 0;
+}
+
+std::vector<uint8_t> ReadFile(const std::string& path)
+{
+    std::ifstream fileStream(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(fileStream), std::istreambuf_iterator<char>());
+}
+
+void WriteFile(const std::string& path, const std::vector<uint8_t>& data)
+{
+    std::ofstream fileStream(path, std::ios::binary | std::ios::trunc);
+    fileStream.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+bool WriteTestFile(const std::string& path, const std::string& key)
+{
+    const std::vector<uint8_t> first  = { 1, 2, 3 };
+    const std::vector<uint8_t> second(1000, 42);
+    return CacheFile::Write(path, key, { { "first", first.data(), first.size() },
+                                         { "second", second.data(), second.size() } });
+}
+
+/// Prepares the convolution of the padding tests, and checks the result of its execution
+android::sp<IPreparedModel> PrepareAndExecuteConvolution(ArmnnDriver& driver)
+{
+    V1_0::Model model = {};
+
+    float weightValue[] = {1.f, -1.f, 0.f, 1.f};
+    float biasValue[]   = {0.f};
+
+    AddInputOperand(model, hidl_vec<uint32_t>{1, 2, 3, 1});
+    AddTensorOperand(model, hidl_vec<uint32_t>{1, 2, 2, 1}, weightValue);
+    AddTensorOperand(model, hidl_vec<uint32_t>{1}, biasValue);
+    AddIntOperand(model, (int32_t)android::nn::kPaddingValid); // padding
+    AddIntOperand(model, 2); // stride x
+    AddIntOperand(model, 2); // stride y
+    AddIntOperand(model, 0); // no activation
+    AddOutputOperand(model, hidl_vec<uint32_t>{1, 1, 1, 1});
+
+    model.operations.resize(1);
+    model.operations[0].type    = V1_0::OperationType::CONV_2D;
+    model.operations[0].inputs  = hidl_vec<uint32_t>{0, 1, 2, 3, 4, 5, 6};
+    model.operations[0].outputs = hidl_vec<uint32_t>{7};
+
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, driver);
+
+    DataLocation inloc    = {};
+    inloc.poolIndex       = 0;
+    inloc.offset          = 0;
+    inloc.length          = 6 * sizeof(float);
+    RequestArgument input = {};
+    input.location        = inloc;
+    input.dimensions      = hidl_vec<uint32_t>{};
+
+    DataLocation outloc    = {};
+    outloc.poolIndex       = 1;
+    outloc.offset          = 0;
+    outloc.length          = sizeof(float);
+    RequestArgument output = {};
+    output.location        = outloc;
+    output.dimensions      = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+
+    float indata[] = {1024.25f, 1.f, 0.f, 3.f, -1, -1024.25f};
+    AddPoolAndSetData(6, request, indata);
+    android::sp<IMemory> outMemory = AddPoolAndGetData(1, request);
+    float* outdata = static_cast<float*>(static_cast<void*>(outMemory->getPointer()));
+
+    Execute(preparedModel, request);
+
+    BOOST_TEST(outdata[0] == 1022.25f);
+    return preparedModel;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(CacheFileRoundTrip)
+{
+    TempDir dir;
+    const std::string path = dir.GetPath() + "/test.armnn-cache";
+
+    BOOST_TEST(!CacheFile::Open(path, "key"));
+    BOOST_TEST(WriteTestFile(path, "key"));
+
+    std::unique_ptr<CacheFile> file = CacheFile::Open(path, "key");
+    BOOST_REQUIRE(file);
+    BOOST_REQUIRE(file->GetBlobs().size() == 2);
+
+    const CacheFile::Blob& first = file->GetBlobs()[0];
+    BOOST_TEST(first.m_Name == "first");
+    BOOST_TEST((std::vector<uint8_t>(first.m_Data, first.m_Data + first.m_NumBytes) ==
+                std::vector<uint8_t>{ 1, 2, 3 }));
+
+    const CacheFile::Blob& second = file->GetBlobs()[1];
+    BOOST_TEST(second.m_Name == "second");
+    BOOST_TEST((std::vector<uint8_t>(second.m_Data, second.m_Data + second.m_NumBytes) ==
+                std::vector<uint8_t>(1000, 42)));
+}
+
+BOOST_AUTO_TEST_CASE(CorruptCacheFileIsDiscarded)
+{
+    TempDir dir;
+    const std::string path = dir.GetPath() + "/test.armnn-cache";
+    BOOST_TEST(WriteTestFile(path, "key"));
+
+    std::vector<uint8_t> data = ReadFile(path);
+    data[data.size() / 2] ^= 0xff;
+    WriteFile(path, data);
+
+    BOOST_TEST(!CacheFile::Open(path, "key"));
+    BOOST_TEST(!FileExists(path));
+
+    // A truncated file is discarded as well
+    BOOST_TEST(WriteTestFile(path, "key"));
+    data = ReadFile(path);
+    data.resize(data.size() - 1);
+    WriteFile(path, data);
+
+    BOOST_TEST(!CacheFile::Open(path, "key"));
+    BOOST_TEST(!FileExists(path));
+}
+
+BOOST_AUTO_TEST_CASE(StaleCacheFileIsDiscarded)
+{
+    TempDir dir;
+    const std::string path = dir.GetPath() + "/test.armnn-cache";
+    BOOST_TEST(WriteTestFile(path, "old driver"));
+
+    BOOST_TEST(!CacheFile::Open(path, "new driver"));
+    BOOST_TEST(!FileExists(path));
+}
+
+BOOST_AUTO_TEST_CASE(ColdVersusWarmPrepare)
+{
+    using Clock = std::chrono::steady_clock;
+
+    TempDir dir;
+    const std::vector<std::string> arguments = { "--compute", "GpuAcc", "--cache-dir", dir.GetPath() };
+
+    // The first driver compiles the OpenCL programs of the model and saves them
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions(arguments));
+    Clock::time_point start = Clock::now();
+    PrepareAndExecuteConvolution(*driver);
+    const auto coldPrepare = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    BOOST_TEST(FileExists(dir.GetPath() + "/cl_programs.armnn-cache"));
+
+    // Releasing the driver releases OpenCL and its compiled programs, as when the driver restarts
+    driver.reset();
+    driver = std::make_unique<ArmnnDriver>(CreateDriverOptions(arguments));
+    start = Clock::now();
+    PrepareAndExecuteConvolution(*driver);
+    const auto warmPrepare = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+
+    BOOST_TEST_MESSAGE("Prepare and execute with a cold cache: " << coldPrepare.count() << " ms, "
+                       "with a warm cache: " << warmPrepare.count() << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,225 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "../RequestQueue.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(RequestQueueTests)
+
+using namespace armnn_driver;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// The same queue protected by a mutex and a condition variable, used as a baseline for the latency benchmark
+template<typename T>
+class LockedQueue
+{
+public:
+    void Push(T& item)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Queue.push(item);
+        m_Cv.notify_one();
+    }
+
+    void Pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (m_Queue.empty())
+        {
+            m_Cv.wait(lock);
+        }
+        item = m_Queue.front();
+        m_Queue.pop();
+    }
+
+private:
+    std::queue<T> m_Queue;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+};
+
+// Measures the time from the moment an item is pushed to the moment the consumer thread pops it.
+// The producer waits for each item to be consumed before pushing the next one, like a client
+// issuing back-to-back requests, and pauses for the given time in between.
+// @return the 50th and 99th percentile latencies in microseconds
+template<typename Queue>
+std::pair<double, double> MeasureLatency(Queue& queue, unsigned int numItems, std::chrono::microseconds pause)
+{
+    std::vector<double> latencies(numItems);
+    std::atomic<unsigned int> consumed(0);
+
+    std::thread consumer([&]()
+    {
+        for (unsigned int i = 0; i < numItems; ++i)
+        {
+            Clock::time_point pushTime;
+            queue.Pop(pushTime);
+            latencies[i] = std::chrono::duration<double, std::micro>(Clock::now() - pushTime).count();
+            consumed.store(i + 1, std::memory_order_release);
+        }
+    });
+
+    for (unsigned int i = 0; i < numItems; ++i)
+    {
+        Clock::time_point pushTime = Clock::now();
+        queue.Push(pushTime);
+        while (consumed.load(std::memory_order_acquire) <= i)
+        {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(pause);
+    }
+    consumer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    return std::make_pair(latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100]);
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(FifoOrder)
+{
+    RequestQueue<int> queue(4);
+    BOOST_TEST(queue.GetCapacity() == 4);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        int in = i;
+        BOOST_TEST(queue.TryPush(in));
+        int out = -1;
+        BOOST_TEST(queue.TryPop(out));
+        BOOST_TEST(out == i);
+    }
+
+    int out = -1;
+    BOOST_TEST(!queue.TryPop(out));
+}
+
+BOOST_AUTO_TEST_CASE(CapacityIsBounded)
+{
+    // The capacity is rounded up to a power of two
+    RequestQueue<int> queue(3);
+    BOOST_TEST(queue.GetCapacity() == 4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        BOOST_TEST(queue.TryPush(i));
+    }
+
+    int extra = 4;
+    BOOST_TEST(!queue.TryPush(extra));
+    BOOST_TEST(extra == 4);
+
+    int out = -1;
+    BOOST_TEST(queue.TryPop(out));
+    BOOST_TEST(out == 0);
+    BOOST_TEST(queue.TryPush(extra));
+}
+
+BOOST_AUTO_TEST_CASE(MultipleProducers)
+{
+    const int numProducers = 4;
+    const int itemsPerProducer = 10000;
+
+    // A small queue, so that the producers regularly find it full and the consumer regularly parks
+    RequestQueue<int> queue(16, 10);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; ++p)
+    {
+        producers.emplace_back([&queue, p]()
+        {
+            for (int i = 0; i < itemsPerProducer; ++i)
+            {
+                int item = p * itemsPerProducer + i;
+                queue.Push(item);
+            }
+        });
+    }
+
+    // Items from each producer must be received in the order they were pushed
+    std::vector<int> lastReceived(numProducers, -1);
+    bool inOrder = true;
+    for (int i = 0; i < numProducers * itemsPerProducer; ++i)
+    {
+        int item = -1;
+        queue.Pop(item);
+        const int producer = item / itemsPerProducer;
+        inOrder = inOrder && (item % itemsPerProducer) > lastReceived[producer];
+        lastReceived[producer] = item % itemsPerProducer;
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    BOOST_TEST(inOrder);
+    for (int p = 0; p < numProducers; ++p)
+    {
+        BOOST_TEST(lastReceived[p] == itemsPerProducer - 1);
+    }
+    int out = -1;
+    BOOST_TEST(!queue.TryPop(out));
+}
+
+BOOST_AUTO_TEST_CASE(PopUntilDeadline)
+{
+    RequestQueue<int> queue(4, 10);
+
+    // An empty queue times out
+    int out = -1;
+    const auto start = Clock::now();
+    BOOST_TEST(!queue.PopUntil(out, start + std::chrono::milliseconds(10)));
+    BOOST_TEST((Clock::now() - start >= std::chrono::milliseconds(10)));
+
+    // An item pushed while waiting is returned
+    std::thread producer([&queue]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        int item = 42;
+        queue.Push(item);
+    });
+    BOOST_TEST(queue.PopUntil(out, Clock::now() + std::chrono::seconds(10)));
+    BOOST_TEST(out == 42);
+    producer.join();
+}
+
+// Microbenchmark of the enqueue-to-dequeue latency, compared with a mutex and condition variable queue.
+// Short pauses between items are absorbed by the consumer spinning, long pauses make it park.
+// The timings are only reported, as they depend on the load and the number of cores of the test device.
+BOOST_AUTO_TEST_CASE(EnqueueToDequeueLatency)
+{
+    const unsigned int numItems = 2000;
+
+    for (auto pause : { std::chrono::microseconds(0), std::chrono::microseconds(200) })
+    {
+        RequestQueue<Clock::time_point> requestQueue(256);
+        LockedQueue<Clock::time_point> lockedQueue;
+
+        const auto requestQueueLatency = MeasureLatency(requestQueue, numItems, pause);
+        const auto lockedQueueLatency  = MeasureLatency(lockedQueue, numItems, pause);
+
+        BOOST_TEST_MESSAGE("Enqueue-to-dequeue latency p50/p99 with " << pause.count() << "us between requests: "
+                           << requestQueueLatency.first << "/" << requestQueueLatency.second << "us (RequestQueue), "
+                           << lockedQueueLatency.first << "/" << lockedQueueLatency.second
+                           << "us (mutex and condition variable)");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
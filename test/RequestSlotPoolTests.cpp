@@ -0,0 +1,310 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ArmnnPreparedModel.hpp"
+#include "../MemoryPoolCache.hpp"
+#include "../RequestSlotPool.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <cutils/native_handle.h>
+#include <OperationsUtils.h>
+
+#if defined(ARMNN_ANDROID_P)
+// The headers of the ML framework have changed between Android O and Android P.
+// The validation functions have been moved into their own header, ValidateHal.h.
+#include <ValidateHal.h>
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+BOOST_AUTO_TEST_SUITE(RequestSlotPoolTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+/// A regular file shared with the driver through "mmap_fd" pools, as done for the memory of a file descriptor
+class MmapFdFile
+{
+public:
+    explicit MmapFdFile(uint32_t size)
+    {
+        char path[] = "/data/local/tmp/armnn-pool-XXXXXX";
+        m_Fd = mkstemp(path);
+        BOOST_REQUIRE(m_Fd >= 0);
+        unlink(path);
+        BOOST_REQUIRE(ftruncate(m_Fd, size) == 0);
+    }
+
+    ~MmapFdFile()
+    {
+        for (native_handle_t* handle : m_Handles)
+        {
+            native_handle_delete(handle);
+        }
+        close(m_Fd);
+    }
+
+    /// Returns a pool mapping size bytes of the file from offset, which must be a multiple of the page size
+    hidl_memory GetPool(uint64_t offset, uint32_t size)
+    {
+        native_handle_t* handle = native_handle_create(1, 3);
+        handle->data[0] = m_Fd;
+        handle->data[1] = PROT_READ | PROT_WRITE;
+        handle->data[2] = static_cast<int>(offset & 0xffffffff);
+        handle->data[3] = static_cast<int>(offset >> 32);
+        m_Handles.push_back(handle);
+        return hidl_memory("mmap_fd", handle, size);
+    }
+
+    void Write(uint64_t offset, const float* values, std::size_t count)
+    {
+        BOOST_REQUIRE(pwrite(m_Fd, values, count * sizeof(float), static_cast<off_t>(offset)) ==
+                      static_cast<ssize_t>(count * sizeof(float)));
+    }
+
+    float Read(uint64_t offset)
+    {
+        float value = 0;
+        BOOST_REQUIRE(pread(m_Fd, &value, sizeof(float), static_cast<off_t>(offset)) == sizeof(float));
+        return value;
+    }
+
+private:
+    int                           m_Fd;
+    std::vector<native_handle_t*> m_Handles;
+};
+
+/// Creates a request for the model of CreateFullyConnectedModel(), reading its input from the first pool and
+/// writing its output to the second one
+Request CreateRequest(const hidl_memory& inputPool, const hidl_memory& outputPool)
+{
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 3 * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 1 * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    request.pools   = hidl_vec<hidl_memory>{inputPool, outputPool};
+    return request;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SlotsAreRecycled)
+{
+    RequestSlotPool pool;
+
+    RequestSlot* slot = pool.Acquire(2, 1, 1);
+    BOOST_TEST(pool.GetNumSlots() == 1);
+    BOOST_TEST(slot->m_MemPools.capacity() >= 2);
+    BOOST_TEST(slot->m_InputTensors.capacity() >= 1);
+    BOOST_TEST(slot->m_OutputTensors.capacity() >= 1);
+    const std::size_t warmGrowths = pool.GetNumGrowths();
+
+    slot->m_InputTensors.emplace_back(0, armnn::ConstTensor());
+    pool.Release(slot);
+    BOOST_TEST(slot->m_InputTensors.empty());
+
+    // The released slot is handed out again, without growing the pool
+    for (int i = 0; i < 10; ++i)
+    {
+        RequestSlot* recycled = pool.Acquire(2, 1, 1);
+        BOOST_TEST(recycled == slot);
+        pool.Release(recycled);
+    }
+    BOOST_TEST(pool.GetNumSlots() == 1);
+    BOOST_TEST(pool.GetNumGrowths() == warmGrowths);
+
+    // A second slot is only created while the first one is in use
+    RequestSlot* first  = pool.Acquire(2, 1, 1);
+    RequestSlot* second = pool.Acquire(2, 1, 1);
+    BOOST_TEST(first != second);
+    BOOST_TEST(pool.GetNumSlots() == 2);
+    pool.Release(first);
+    pool.Release(second);
+
+    // Growing a recycled slot is counted
+    const std::size_t growths = pool.GetNumGrowths();
+    pool.Release(pool.Acquire(2, 16, 1));
+    BOOST_TEST(pool.GetNumGrowths() > growths);
+}
+
+BOOST_AUTO_TEST_CASE(SteadyStateExecuteReusesRequestSlots)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(), *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+    auto armnnPreparedModel = static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get());
+
+    // The input and output in two pages of a file, whose mappings are cached
+    const uint32_t pageSize = static_cast<uint32_t>(getpagesize());
+    MmapFdFile file(2 * pageSize);
+    const Request request = CreateRequest(file.GetPool(0, 3 * sizeof(float)), file.GetPool(pageSize, sizeof(float)));
+    const float indata[] = {2, 32, 16};
+    file.Write(0, indata, 3);
+
+    // The first request creates the slot
+    Execute(preparedModel, request);
+    BOOST_TEST(file.Read(pageSize) == 152);
+    const std::size_t warmGrowths = armnnPreparedModel->GetNumRequestSlotGrowths();
+    BOOST_TEST(warmGrowths > 0);
+
+    // Requests submitted after the previous one has completed reuse it
+    const int numRequests = 20;
+    const float zero = 0;
+    for (int i = 0; i < numRequests; ++i)
+    {
+        file.Write(pageSize, &zero, 1);
+        Execute(preparedModel, request);
+        BOOST_TEST(file.Read(pageSize) == 152);
+    }
+    BOOST_TEST(armnnPreparedModel->GetNumRequestSlotGrowths() == warmGrowths);
+
+    // The input and output pools are only mapped for the first request
+    BOOST_TEST(armnnPreparedModel->GetMemoryPoolCache().GetNumMisses() == 2);
+    BOOST_TEST(armnnPreparedModel->GetMemoryPoolCache().GetNumHits() == 2 * numRequests);
+}
+
+BOOST_AUTO_TEST_CASE(SteadyStateExecuteOnlyAllocatesToValidate)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    const V1_0::Model model = CreateFullyConnectedModel();
+    android::sp<IPreparedModel> preparedModel = PrepareModel(model, *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+
+    // Cached pools, so that the requests do not map them
+    const uint32_t pageSize = static_cast<uint32_t>(getpagesize());
+    MmapFdFile file(2 * pageSize);
+    const Request request = CreateRequest(file.GetPool(0, 3 * sizeof(float)), file.GetPool(pageSize, sizeof(float)));
+    const float indata[] = {2, 32, 16};
+    file.Write(0, indata, 3);
+
+    // The first request creates the slot, maps the pools and links to the death of the client
+    Execute(preparedModel, request);
+    BOOST_TEST(file.Read(pageSize) == 152);
+
+    // The validation of the request by the NN framework allocates, which the driver cannot avoid
+    const V1_0::Model inputsAndOutputs = GetInputsAndOutputsModel(model);
+    std::size_t numValidationAllocations = 0;
+    bool isValid = false;
+    {
+        ScopedAllocationCounter counter;
+        isValid = android::nn::validateRequest(request, inputsAndOutputs);
+        numValidationAllocations = counter.GetNumAllocations();
+    }
+    BOOST_TEST(isValid);
+    BOOST_TEST_MESSAGE("Validating a request makes " << numValidationAllocations << " allocation(s)");
+
+    // Submitting the next requests makes no other allocation
+    for (int i = 0; i < 20; ++i)
+    {
+        android::sp<ExecutionCallback> callback(new ExecutionCallback());
+        ErrorStatus status = ErrorStatus::GENERAL_FAILURE;
+        std::size_t numAllocations = 0;
+        {
+            ScopedAllocationCounter counter;
+            status = preparedModel->execute(request, callback);
+            numAllocations = counter.GetNumAllocations();
+        }
+        callback->wait();
+        BOOST_TEST(status == ErrorStatus::NONE);
+        BOOST_TEST(numAllocations == numValidationAllocations);
+        BOOST_TEST(file.Read(pageSize) == 152);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(MmapFdPoolsAtDifferentOffsetsAreNotShared)
+{
+    const uint32_t pageSize = static_cast<uint32_t>(getpagesize());
+
+    // Two mmap_fd pools mapping the two pages of the same file
+    MmapFdFile file(2 * pageSize);
+    const hidl_vec<hidl_memory> pools{file.GetPool(0, pageSize), file.GetPool(pageSize, pageSize)};
+
+    MemoryPoolCache cache(4);
+    std::vector<std::shared_ptr<android::nn::RunTimePoolInfo>> poolInfos;
+    BOOST_TEST(cache.GetRunTimePoolInfos(pools, poolInfos));
+    BOOST_TEST(poolInfos.size() == 2);
+    BOOST_TEST(poolInfos[0] != poolInfos[1]);
+    BOOST_TEST(cache.GetNumMisses() == 2);
+    BOOST_TEST(cache.GetNumHits() == 0);
+
+    // Each pool is then found again at its own offset
+    std::vector<std::shared_ptr<android::nn::RunTimePoolInfo>> cachedPoolInfos;
+    BOOST_TEST(cache.GetRunTimePoolInfos(pools, cachedPoolInfos));
+    BOOST_TEST(cachedPoolInfos[0] == poolInfos[0]);
+    BOOST_TEST(cachedPoolInfos[1] == poolInfos[1]);
+    BOOST_TEST(cache.GetNumMisses() == 2);
+    BOOST_TEST(cache.GetNumHits() == 2);
+}
+
+// Every ashmem region has the inode of the ashmem device, so regions of the same size must not share a mapping
+BOOST_AUTO_TEST_CASE(AshmemPoolsOfTheSameSizeAreNotShared)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(), *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+    auto armnnPreparedModel = static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get());
+
+    // Two requests with their own input and output pools, of the same sizes
+    const hidl_memory firstInput   = allocateSharedMemory(3 * sizeof(float));
+    const hidl_memory firstOutput  = allocateSharedMemory(sizeof(float));
+    const hidl_memory secondInput  = allocateSharedMemory(3 * sizeof(float));
+    const hidl_memory secondOutput = allocateSharedMemory(sizeof(float));
+    android::sp<IMemory> firstInMemory   = mapMemory(firstInput);
+    android::sp<IMemory> firstOutMemory  = mapMemory(firstOutput);
+    android::sp<IMemory> secondInMemory  = mapMemory(secondInput);
+    android::sp<IMemory> secondOutMemory = mapMemory(secondOutput);
+
+    const float firstIndata[]  = {2, 32, 16};
+    const float secondIndata[] = {1, 1, 1};
+    memcpy(firstInMemory->getPointer(), firstIndata, sizeof(firstIndata));
+    memcpy(secondInMemory->getPointer(), secondIndata, sizeof(secondIndata));
+    float* firstOutdata  = static_cast<float*>(static_cast<void*>(firstOutMemory->getPointer()));
+    float* secondOutdata = static_cast<float*>(static_cast<void*>(secondOutMemory->getPointer()));
+
+    const Request firstRequest  = CreateRequest(firstInput, firstOutput);
+    const Request secondRequest = CreateRequest(secondInput, secondOutput);
+    for (int i = 0; i < 2; ++i)
+    {
+        firstOutdata[0]  = 0;
+        secondOutdata[0] = 0;
+
+        // Each request reads its own input and writes its own output only
+        Execute(preparedModel, firstRequest);
+        BOOST_TEST(firstOutdata[0] == 152);
+        BOOST_TEST(secondOutdata[0] == 0);
+
+        Execute(preparedModel, secondRequest);
+        BOOST_TEST(secondOutdata[0] == 11);
+        BOOST_TEST(firstOutdata[0] == 152);
+    }
+    BOOST_TEST(armnnPreparedModel->GetMemoryPoolCache().GetNumHits() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
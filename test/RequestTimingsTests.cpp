@@ -0,0 +1,119 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ArmnnPreparedModel.hpp"
+#include "../RequestTimings.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(RequestTimingsTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+BOOST_AUTO_TEST_CASE(HistogramPercentiles)
+{
+    LatencyHistogram histogram;
+    BOOST_TEST(histogram.GetCount() == 0);
+    BOOST_TEST(histogram.GetPercentile(50) == 0);
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        histogram.Add(std::chrono::microseconds(i));
+    }
+    BOOST_TEST(histogram.GetCount() == 1000);
+
+    // The buckets are at most 12.5% wide
+    const uint64_t p50 = histogram.GetPercentile(50);
+    const uint64_t p95 = histogram.GetPercentile(95);
+    const uint64_t p99 = histogram.GetPercentile(99);
+    BOOST_TEST((p50 >= 440 && p50 <= 565));
+    BOOST_TEST((p95 >= 830 && p95 <= 1075));
+    BOOST_TEST((p99 >= 870 && p99 <= 1115));
+    BOOST_TEST(p50 <= p95);
+    BOOST_TEST(p95 <= p99);
+
+    // Small durations are exact
+    LatencyHistogram small;
+    small.Add(std::chrono::microseconds(3));
+    BOOST_TEST(small.GetPercentile(99) == 3);
+}
+
+BOOST_AUTO_TEST_CASE(StepsOfARequest)
+{
+    RequestTimings timings;
+    const RequestTimings::Clock::time_point start = RequestTimings::Clock::now();
+    for (unsigned int stage = 0; stage < static_cast<unsigned int>(RequestStage::NumStages); ++stage)
+    {
+        timings.Set(static_cast<RequestStage>(stage), start + std::chrono::microseconds(stage * 100));
+    }
+
+    RequestLatencyStats stats(0);
+    stats.Add(timings);
+    BOOST_TEST(stats.GetNumRequests() == 1);
+
+    const uint64_t queueWait = stats.GetHistogram(RequestStage::Dequeued).GetPercentile(50);
+    const uint64_t total = stats.GetHistogram(RequestStage::Received).GetPercentile(50);
+    BOOST_TEST((queueWait >= 88 && queueWait <= 113));
+    BOOST_TEST((total >= 700 && total <= 900));
+
+    const std::string summary = stats.GetSummary();
+    BOOST_TEST(summary.find("queue_wait") != std::string::npos);
+    BOOST_TEST(summary.find("workload") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(ExecutedRequestsAreTimed)
+{
+    auto driver = std::make_unique<ArmnnDriver>(DriverOptions(armnn::Compute::CpuRef));
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(), *driver);
+    BOOST_TEST(preparedModel.get() != nullptr);
+    auto armnnPreparedModel = static_cast<ArmnnPreparedModel<hal_1_0::HalPolicy>*>(preparedModel.get());
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 3 * sizeof(float);
+    RequestArgument input = {};
+    input.location = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 1 * sizeof(float);
+    RequestArgument output = {};
+    output.location  = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    float indata[] = {2, 32, 16};
+    AddPoolAndSetData(3, request, indata);
+    AddPoolAndGetData(1, request);
+
+    const unsigned int numRequests = 10;
+    for (unsigned int i = 0; i < numRequests; ++i)
+    {
+        Execute(preparedModel, request);
+    }
+
+    // The requests are timed once their callback has been notified, which may be just after Execute returns
+    while (armnnPreparedModel->GetLatencyStats().GetNumRequests() < numRequests)
+    {
+        std::this_thread::yield();
+    }
+
+    const RequestLatencyStats& stats = armnnPreparedModel->GetLatencyStats();
+    BOOST_TEST(stats.GetNumRequests() == numRequests);
+    BOOST_TEST(stats.GetHistogram(RequestStage::WorkloadFinished).GetCount() == numRequests);
+    BOOST_TEST(stats.GetHistogram(RequestStage::Received).GetPercentile(99) >=
+               stats.GetHistogram(RequestStage::WorkloadFinished).GetPercentile(50));
+    BOOST_TEST_MESSAGE("Request latencies (p50/p95/p99 in us): " << stats.GetSummary());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
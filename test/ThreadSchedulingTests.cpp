@@ -0,0 +1,177 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+#include "../ThreadScheduling.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ThreadSchedulingTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+const uint32_t g_NumUnits = 256;
+
+struct LatencyStatistics
+{
+    double m_Mean;
+    double m_StdDev;
+    double m_P50;
+    double m_P99;
+};
+
+// Executes back-to-back requests with a driver created from the given arguments
+// @return the statistics of the end-to-end latencies in microseconds
+LatencyStatistics MeasureExecuteLatency(const std::vector<std::string>& arguments, unsigned int numRequests)
+{
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions(arguments));
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(g_NumUnits, 0.5f), *driver);
+
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = g_NumUnits * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    const std::vector<float> indata(g_NumUnits, 1.0f);
+    AddPoolAndSetData(g_NumUnits, request, indata.data());
+    AddPoolAndGetData(g_NumUnits, request);
+
+    std::vector<double> latencies(numRequests);
+    for (unsigned int i = 0; i < numRequests; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        Execute(preparedModel, request);
+        latencies[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    LatencyStatistics statistics;
+    statistics.m_Mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / numRequests;
+    double sumOfSquares = 0.0;
+    for (double latency : latencies)
+    {
+        sumOfSquares += (latency - statistics.m_Mean) * (latency - statistics.m_Mean);
+    }
+    statistics.m_StdDev = std::sqrt(sumOfSquares / numRequests);
+
+    std::sort(latencies.begin(), latencies.end());
+    statistics.m_P50 = latencies[numRequests / 2];
+    statistics.m_P99 = latencies[numRequests * 99 / 100];
+    return statistics;
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(ParseCpuLists)
+{
+    std::set<unsigned int> cpus;
+    BOOST_TEST(ParseCpuList("3", cpus));
+    BOOST_TEST((cpus == std::set<unsigned int>{3}));
+
+    BOOST_TEST(ParseCpuList("0-2,5,7-8", cpus));
+    BOOST_TEST((cpus == std::set<unsigned int>{0, 1, 2, 5, 7, 8}));
+
+    BOOST_TEST(!ParseCpuList("", cpus));
+    BOOST_TEST(!ParseCpuList("4-2", cpus));
+    BOOST_TEST(!ParseCpuList("1,a", cpus));
+    BOOST_TEST(!ParseCpuList("1-2-3", cpus));
+    BOOST_TEST(cpus.empty());
+}
+
+BOOST_AUTO_TEST_CASE(SchedulingOptions)
+{
+    DriverOptions options = CreateDriverOptions({
+        "--request-thread-cpus", "0-1,3",
+        "--request-thread-nice", "5",
+        "--request-thread-fifo-priority", "150" });
+
+    const ThreadSchedulingPolicy& policy = options.GetRequestThreadScheduling();
+    BOOST_TEST((policy.m_Cpus == std::set<unsigned int>{0, 1, 3}));
+    BOOST_TEST(policy.m_Nice == 5);
+    BOOST_TEST(policy.m_FifoPriority == 99);
+
+    DriverOptions defaultOptions = CreateDriverOptions({ "--request-thread-cpus", "invalid" });
+    BOOST_TEST(defaultOptions.GetRequestThreadScheduling().IsDefault());
+}
+
+BOOST_AUTO_TEST_CASE(ApplyToThread)
+{
+    ThreadSchedulingPolicy policy;
+    policy.m_Cpus.insert(0);
+    // Lowering the priority of a thread does not require any permission
+    policy.m_Nice = 5;
+
+    bool applied = false;
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    int nice = 0;
+
+    std::thread thread([&]()
+    {
+        applied = ApplyThreadSchedulingPolicy(policy);
+        sched_getaffinity(0, sizeof(cpuSet), &cpuSet);
+        nice = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    });
+    thread.join();
+
+    BOOST_TEST(applied);
+    BOOST_TEST(CPU_COUNT(&cpuSet) == 1);
+    BOOST_TEST(CPU_ISSET(0, &cpuSet));
+    BOOST_TEST(nice == 5);
+
+    // The settings only apply to the thread that applied them
+    BOOST_TEST(getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid))) != 5);
+}
+
+// Benchmark of the variance of the execution latency with the request thread free to migrate between the CPUs,
+// and pinned to the last CPU, usually one of the big cores of a big.LITTLE device.
+// The timings are only reported, as they depend on the load and the topology of the test device.
+BOOST_AUTO_TEST_CASE(PinnedLatencyVariance)
+{
+    const unsigned int numRequests = 500;
+    const long numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    const std::string lastCpu = std::to_string(std::max(numCpus - 1, 0L));
+
+    const LatencyStatistics floating = MeasureExecuteLatency({ "--compute", "CpuRef" }, numRequests);
+    const LatencyStatistics pinned = MeasureExecuteLatency({ "--compute", "CpuRef",
+                                                             "--request-thread-cpus", lastCpu }, numRequests);
+
+    BOOST_TEST_MESSAGE("Execute latency mean/stddev/p50/p99 in us, floating: " << floating.m_Mean << "/"
+                       << floating.m_StdDev << "/" << floating.m_P50 << "/" << floating.m_P99
+                       << ", pinned to CPU " << lastCpu << ": " << pinned.m_Mean << "/" << pinned.m_StdDev << "/"
+                       << pinned.m_P50 << "/" << pinned.m_P99);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
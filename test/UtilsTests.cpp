@@ -9,6 +9,15 @@
 
 #include "../Utils.hpp"
 
+#include <OperationsUtils.h>
+
+#if defined(ARMNN_ANDROID_P)
+// The headers of the ML framework have changed between Android O and Android P.
+// The validation functions have been moved into their own header, ValidateHal.h.
+#include <ValidateHal.h>
+#endif
+
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <boost/format.hpp>
@@ -20,6 +29,7 @@ using namespace android;
 using namespace android::nn;
 using namespace android::hardware;
 using namespace armnn_driver;
+using namespace driverTestHelpers;
 
 // The following are helpers for writing unit tests for the driver.
 namespace
@@ -257,4 +267,69 @@ BOOST_AUTO_TEST_CASE(ExportMultipleNetworks)
     BOOST_TEST(fixture3.GetFileContent() == mockSerializedContent);
 }
 
+BOOST_AUTO_TEST_CASE(OutputPoolIndexesExcludeInputOnlyPools)
+{
+    auto makeArgument = [](uint32_t poolIndex, uint32_t offset)
+    {
+        RequestArgument argument = {};
+        argument.location.poolIndex = poolIndex;
+        argument.location.offset    = offset;
+        argument.location.length    = sizeof(float);
+        return argument;
+    };
+
+    // Pool 0 only holds inputs, pool 1 holds an input and two outputs, pool 2 only holds an output
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{ makeArgument(0, 0), makeArgument(0, 4), makeArgument(1, 0) };
+    request.outputs = hidl_vec<RequestArgument>{ makeArgument(2, 0), makeArgument(1, 4), makeArgument(1, 8) };
+
+    std::vector<uint32_t> poolIndexes = { 7 };
+    GetOutputPoolIndexes(request, poolIndexes);
+
+    BOOST_TEST(poolIndexes.size() == 2);
+    BOOST_TEST((std::find(poolIndexes.begin(), poolIndexes.end(), 1) != poolIndexes.end()));
+    BOOST_TEST((std::find(poolIndexes.begin(), poolIndexes.end(), 2) != poolIndexes.end()));
+    BOOST_TEST((std::find(poolIndexes.begin(), poolIndexes.end(), 0) == poolIndexes.end()));
+
+    // A request without outputs does not update any pool
+    request.outputs = hidl_vec<RequestArgument>{};
+    GetOutputPoolIndexes(request, poolIndexes);
+    BOOST_TEST(poolIndexes.empty());
+}
+
+BOOST_AUTO_TEST_CASE(InputsAndOutputsModelValidatesRequests)
+{
+    const V1_0::Model model = CreateFullyConnectedModel();
+
+    // Only the input and output operands are kept
+    const V1_0::Model inputsAndOutputs = GetInputsAndOutputsModel(model);
+    BOOST_TEST(inputsAndOutputs.operands.size() == 2);
+    BOOST_TEST(inputsAndOutputs.operations.size() == 0);
+    BOOST_TEST(inputsAndOutputs.operandValues.size() == 0);
+    BOOST_TEST(inputsAndOutputs.operands[inputsAndOutputs.inputIndexes[0]].dimensions[1] == 3);
+    BOOST_TEST(inputsAndOutputs.operands[inputsAndOutputs.outputIndexes[0]].dimensions[1] == 1);
+
+    RequestArgument input = {};
+    input.location.poolIndex = 0;
+    input.location.length    = 3 * sizeof(float);
+    RequestArgument output = {};
+    output.location.poolIndex = 1;
+    output.location.length    = 1 * sizeof(float);
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    float indata[] = {2, 32, 16};
+    AddPoolAndSetData(3, request, indata);
+    AddPoolAndGetData(1, request);
+
+    // A request is validated in the same way against both models
+    BOOST_TEST(validateRequest(request, model));
+    BOOST_TEST(validateRequest(request, inputsAndOutputs));
+
+    request.inputs[0].dimensions = hidl_vec<uint32_t>{1, 4};
+    BOOST_TEST(!validateRequest(request, model));
+    BOOST_TEST(!validateRequest(request, inputsAndOutputs));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
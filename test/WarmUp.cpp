@@ -0,0 +1,96 @@
+//
+// Copyright © 2017 Arm Ltd. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+#include "DriverTestHelpers.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <log/log.h>
+
+BOOST_AUTO_TEST_SUITE(WarmUpTests)
+
+using ArmnnDriver = armnn_driver::ArmnnDriver;
+using namespace android::hardware;
+using namespace driverTestHelpers;
+using namespace armnn_driver;
+
+namespace
+{
+
+// Executes the model of CreateFullyConnectedModel() with the input {2, 32, 16}
+float ExecuteAndGetOutput(const android::sp<IPreparedModel>& preparedModel)
+{
+    DataLocation inloc = {};
+    inloc.poolIndex = 0;
+    inloc.offset    = 0;
+    inloc.length    = 3 * sizeof(float);
+    RequestArgument input = {};
+    input.location   = inloc;
+    input.dimensions = hidl_vec<uint32_t>{};
+
+    DataLocation outloc = {};
+    outloc.poolIndex = 1;
+    outloc.offset    = 0;
+    outloc.length    = 1 * sizeof(float);
+    RequestArgument output = {};
+    output.location   = outloc;
+    output.dimensions = hidl_vec<uint32_t>{};
+
+    Request request = {};
+    request.inputs  = hidl_vec<RequestArgument>{input};
+    request.outputs = hidl_vec<RequestArgument>{output};
+    float indata[] = {2, 32, 16};
+    AddPoolAndSetData(3, request, indata);
+    android::sp<IMemory> outMemory = AddPoolAndGetData(1, request);
+
+    Execute(preparedModel, request);
+    return static_cast<float*>(static_cast<void*>(outMemory->getPointer()))[0];
+}
+
+void CheckWarmUpPolicy(const std::string& policy)
+{
+    DriverOptions options = CreateDriverOptions({ "--compute", "CpuRef", "--warm-up", policy });
+    BOOST_TEST((options.GetWarmUpPolicy() == (policy == "Never"    ? WarmUpPolicy::Never :
+                                              policy == "Deferred" ? WarmUpPolicy::Deferred :
+                                                                     WarmUpPolicy::Always)));
+    auto driver = std::make_unique<ArmnnDriver>(std::move(options));
+
+    // The request is submitted as soon as the model is notified, racing with a deferred warm-up
+    android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(), *driver);
+    BOOST_TEST(ExecuteAndGetOutput(preparedModel) == 152);
+    BOOST_TEST(ExecuteAndGetOutput(preparedModel) == 152);
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(AlwaysWarmUp)
+{
+    CheckWarmUpPolicy("Always");
+}
+
+BOOST_AUTO_TEST_CASE(NeverWarmUp)
+{
+    CheckWarmUpPolicy("Never");
+}
+
+BOOST_AUTO_TEST_CASE(DeferredWarmUp)
+{
+    CheckWarmUpPolicy("Deferred");
+}
+
+// The driver keeps the model alive until its deferred warm-up completes, even if the client releases it first
+BOOST_AUTO_TEST_CASE(ReleaseModelBeforeDeferredWarmUp)
+{
+    auto driver = std::make_unique<ArmnnDriver>(CreateDriverOptions({ "--compute", "CpuRef",
+                                                                     "--warm-up", "Deferred" }));
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+        android::sp<IPreparedModel> preparedModel = PrepareModel(CreateFullyConnectedModel(), *driver);
+        BOOST_TEST(preparedModel.get() != nullptr);
+    }
+
+    // Destroying the driver completes the pending warm-ups
+    driver.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()